@@ -0,0 +1,139 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+/**
+ * @defgroup cpu cpu
+ * @brief Instruction set detection for dispatching array kernels to wider registers.
+ * @details The array kernels in vec.h are compiled for the minimum instruction set of the build,
+ * and also for AVX2 and AVX-512 by way of target attributes. At run time, each kernel selects the
+ * widest instruction set the processor supports, so that one binary runs on old and new machines.
+ * The half precision array conversions likewise select F16C where it is supported.
+ * Define `QUEMATH_DISPATCH` to `0` to compile only for the minimum instruction set.
+ * @{
+ */
+
+#if !defined(QUEMATH_DISPATCH)
+ #if defined(__GNUC__)
+  #define QUEMATH_DISPATCH 1
+ #else
+  #define QUEMATH_DISPATCH 0
+ #endif
+#endif
+
+#if QUEMATH_DISPATCH
+ #define QUEMATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+ #define QUEMATH_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+ #define QUEMATH_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+ #define QUEMATH_TARGET_AVX2
+ #define QUEMATH_TARGET_AVX512
+ #define QUEMATH_TARGET_F16C
+#endif
+
+/**
+ * @brief Non-zero if the AVX2 kernels are compiled, either for dispatch or as the minimum.
+ */
+#if QUEMATH_DISPATCH || (defined(__AVX2__) && defined(__FMA__))
+ #define QUEMATH_AVX2 1
+#else
+ #define QUEMATH_AVX2 0
+#endif
+
+/**
+ * @brief Non-zero if the AVX-512 kernels are compiled, either for dispatch or as the minimum.
+ */
+#if QUEMATH_DISPATCH || (defined(__AVX512F__) && defined(__AVX2__) && defined(__FMA__))
+ #define QUEMATH_AVX512 1
+#else
+ #define QUEMATH_AVX512 0
+#endif
+
+/**
+ * @brief Non-zero if the F16C kernels are compiled, either for dispatch or as the minimum.
+ */
+#if QUEMATH_DISPATCH || defined(__F16C__)
+ #define QUEMATH_F16C 1
+#else
+ #define QUEMATH_F16C 0
+#endif
+
+/**
+ * @brief Non-zero if the minimum instruction set includes fused multiply-add.
+ * @details When set, vec_multiply_add and the functions built upon it, such as vec_scale_add,
+ * vec_mix and vec_cross, round once rather than twice. Define `QUEMATH_HAS_FMA` to `0` to
+ * reproduce the results of builds without FMA.
+ */
+#if !defined(QUEMATH_HAS_FMA)
+ #if defined(__FMA__)
+  #define QUEMATH_HAS_FMA 1
+ #else
+  #define QUEMATH_HAS_FMA 0
+ #endif
+#endif
+
+static inline int cpu_has_avx2(void);
+static inline int cpu_has_avx512(void);
+static inline int cpu_has_f16c(void);
+
+/**
+ * @return Non-zero if the processor and operating system support AVX2 and FMA.
+ */
+static int cpu_has_avx2(void) {
+#if defined(__AVX2__) && defined(__FMA__)
+	return 1;
+#elif QUEMATH_DISPATCH
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @return Non-zero if the processor and operating system support AVX-512F, as well as AVX2.
+ */
+static int cpu_has_avx512(void) {
+#if defined(__AVX512F__) && defined(__AVX2__) && defined(__FMA__)
+	return 1;
+#elif QUEMATH_DISPATCH
+	return __builtin_cpu_supports("avx512f") && cpu_has_avx2();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @return Non-zero if the processor and operating system support F16C half precision conversion.
+ */
+static int cpu_has_f16c(void) {
+#if defined(__F16C__)
+	return 1;
+#elif QUEMATH_DISPATCH
+	return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+#else
+	return 0;
+#endif
+}
+
+/** @} */
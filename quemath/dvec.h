@@ -0,0 +1,600 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include "vec.h"
+
+/**
+ * @defgroup dvec dvec
+ * @brief Four component double precision vectors, for large world coordinates.
+ * @details Single precision positions lose millimeter precision a few kilometers from the origin.
+ * Keep world positions in double precision, and convert them to single precision vectors relative
+ * to the camera, or to any nearby origin, before the hot loops. Where AVX2 is the minimum
+ * instruction set, dvec is a single 256 bit register; otherwise it is a pair of 128 bit registers.
+ * @{
+ */
+
+/**
+ * @brief Three component double precision vector type.
+ */
+typedef union {
+	/**
+	 * @brief Array accessor.
+	 */
+	double v[3];
+
+	/**
+	 * @brief Component accessors.
+	 */
+	struct {
+		double x, y, z;
+	};
+} dvec3;
+
+/**
+ * @brief Four component double precision vector type.
+ */
+typedef union {
+	/**
+	 * @brief Array accessor.
+	 */
+	double v[4];
+
+	/**
+	 * @brief Component accessors.
+	 */
+	struct {
+		double x, y, z, w;
+	};
+} dvec4;
+
+#if defined(__AVX2__)
+
+/**
+ * @brief Four component double precision AVX vector type.
+ */
+typedef __m256d dvec;
+
+#else
+
+/**
+ * @brief Four component double precision SSE vector type, as a pair of registers.
+ */
+typedef struct {
+	/**
+	 * @brief The `x` and `y` components.
+	 */
+	__m128d xy;
+
+	/**
+	 * @brief The `z` and `w` components.
+	 */
+	__m128d zw;
+} dvec;
+
+#endif
+
+static inline dvec dvec0(void);
+static inline dvec dvec3f(double x, double y, double z);
+static inline dvec dvec3fv(const dvec3 f);
+static inline dvec dvec4f(double x, double y, double z, double w);
+static inline dvec dvec4fv(const dvec4 f);
+
+static inline dvec dvec_add(const dvec a, const dvec b);
+static inline dvec dvec_convert_vec(const vec v);
+static inline dvec dvec_cross(const dvec a, const dvec b);
+static inline dvec dvec_distance(const dvec a, const dvec b);
+static inline dvec dvec_divide(const dvec a, const dvec b);
+static inline dvec dvec_dot3(const dvec a, const dvec b);
+static inline dvec dvec_dot4(const dvec a, const dvec b);
+static inline dvec3 dvec_dvec3(const dvec v);
+static inline dvec4 dvec_dvec4(const dvec v);
+static inline int dvec_equal(const dvec a, const dvec b);
+static inline dvec dvec_length(const dvec v);
+static inline dvec dvec_max(const dvec a, const dvec b);
+static inline dvec dvec_min(const dvec a, const dvec b);
+static inline dvec dvec_mix(const dvec a, const dvec b, double mix);
+static inline dvec dvec_multiply(const dvec a, const dvec b);
+static inline dvec dvec_multiply_add(const dvec a, const dvec b, const dvec c);
+static inline dvec dvec_negate(const dvec v);
+static inline dvec dvec_new(double d);
+static inline dvec dvec_normalize(const dvec v);
+static inline dvec dvec_scale(const dvec v, double scale);
+static inline dvec dvec_scale_add(const dvec a, const dvec b, double scale);
+static inline dvec dvec_sqrt(const dvec v);
+static inline dvec dvec_subtract(const dvec a, const dvec b);
+static inline double dvec_w(const dvec v);
+static inline double dvec_x(const dvec v);
+static inline double dvec_y(const dvec v);
+static inline dvec dvec_yzx(const dvec v);
+static inline double dvec_z(const dvec v);
+static inline dvec dvec_zxy(const dvec v);
+
+static inline vec vec_convert_dvec(const dvec v);
+static inline vec vec_convert_dvec_relative(const dvec v, const dvec origin);
+
+static inline void vec3_convert_dvec3_relative_array(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count);
+static inline void vec3_convert_dvec3_relative_array_sse(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count);
+
+#if QUEMATH_AVX2
+static inline void vec3_convert_dvec3_relative_array_avx2(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count) QUEMATH_TARGET_AVX2;
+#endif
+
+/**
+ * @return A vector with all components set to `0`.
+ */
+static dvec dvec0(void) {
+	return dvec_new(0);
+}
+
+/**
+ * @brief Creates a vector with components `(x, y, z, 0)`.
+ * @return A vector with components `(x, y, z, 0)`.
+ */
+static dvec dvec3f(double x, double y, double z) {
+	return dvec4f(x, y, z, 0);
+}
+
+/**
+ * @brief Creates a vector with components `(f.x, f.y, f.z, 0)`.
+ * @return A vector with components `(f.x, f.y, f.z, 0)`.
+ */
+static dvec dvec3fv(const dvec3 f) {
+	return dvec3f(f.x, f.y, f.z);
+}
+
+/**
+ * @brief Creates a vector with components `(x, y, z, w)`.
+ * @return A vector with components `(x, y, z, w)`.
+ */
+static dvec dvec4f(double x, double y, double z, double w) {
+#if defined(__AVX2__)
+	return _mm256_setr_pd(x, y, z, w);
+#else
+	return (dvec) { _mm_setr_pd(x, y), _mm_setr_pd(z, w) };
+#endif
+}
+
+/**
+ * @brief Creates a vector with components `(f.x, f.y, f.z, f.w)`.
+ * @return A vector with components `(f.x, f.y, f.z, f.w)`.
+ */
+static dvec dvec4fv(const dvec4 f) {
+#if defined(__AVX2__)
+	return _mm256_loadu_pd(f.v);
+#else
+	return (dvec) { _mm_loadu_pd(f.v), _mm_loadu_pd(f.v + 2) };
+#endif
+}
+
+/**
+ * @brief Calculates the sum of @p a `+` @p b.
+ * @return A vector containing the sum of @p a `+` @p b.
+ */
+static dvec dvec_add(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_add_pd(a, b);
+#else
+	return (dvec) { _mm_add_pd(a.xy, b.xy), _mm_add_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @brief Converts the single precision vector @p v to double precision, exactly.
+ * @return A double precision vector equal to @p v.
+ */
+static dvec dvec_convert_vec(const vec v) {
+#if defined(__AVX2__)
+	return _mm256_cvtps_pd(v);
+#else
+	return (dvec) { _mm_cvtps_pd(v), _mm_cvtps_pd(_mm_movehl_ps(v, v)) };
+#endif
+}
+
+/**
+ * @brief Calculates the cross product of @p a `×` @p b.
+ * @return A vector containing the cross product of @p a and @p b.
+ */
+static dvec dvec_cross(const dvec a, const dvec b) {
+	return dvec_subtract(
+		dvec_multiply(dvec_yzx(a), dvec_zxy(b)),
+		dvec_multiply(dvec_zxy(a), dvec_yzx(b))
+	);
+}
+
+/**
+ * @brief Calculates the distance between the points @p a and @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the distance between points @p a and @p b.
+ */
+static dvec dvec_distance(const dvec a, const dvec b) {
+	return dvec_length(dvec_subtract(b, a));
+}
+
+/**
+ * @brief Calculates the quotient of @p a `÷` @p b.
+ * @return A vector containing the quotient of @p a `/` @p b.
+ */
+static dvec dvec_divide(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_div_pd(a, b);
+#else
+	return (dvec) { _mm_div_pd(a.xy, b.xy), _mm_div_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @brief Calculates the three-component dot product of @p a `·` @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p a `·` @p b.
+ */
+static dvec dvec_dot3(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return dvec_dot4(_mm256_blend_pd(a, _mm256_setzero_pd(), 0x8), b);
+#else
+	return dvec_dot4((dvec) { a.xy, _mm_move_sd(_mm_setzero_pd(), a.zw) }, b);
+#endif
+}
+
+/**
+ * @brief Calculates the four-component dot product of @p a `·` @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p a `·` @p b.
+ */
+static dvec dvec_dot4(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	const __m256d p = _mm256_mul_pd(a, b);
+	const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(p), _mm256_extractf128_pd(p, 1));
+	const __m128d d = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+	return _mm256_blend_pd(_mm256_setzero_pd(), _mm256_castpd128_pd256(d), 0x1);
+#else
+	const __m128d s = _mm_add_pd(_mm_mul_pd(a.xy, b.xy), _mm_mul_pd(a.zw, b.zw));
+	const __m128d d = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+	return (dvec) { _mm_move_sd(_mm_setzero_pd(), d), _mm_setzero_pd() };
+#endif
+}
+
+/**
+ * @brief Creates a dvec3 containing the first three components of @p v.
+ * @return A dvec3 containing the first three components of @p v.
+ */
+static dvec3 dvec_dvec3(const dvec v) {
+	const dvec4 d = dvec_dvec4(v);
+	return (dvec3) { .v = { d.x, d.y, d.z } };
+}
+
+/**
+ * @brief Creates a dvec4 containing the components of @p v.
+ * @return A dvec4 containing the components of @p v.
+ */
+static dvec4 dvec_dvec4(const dvec v) {
+	dvec4 d;
+#if defined(__AVX2__)
+	_mm256_storeu_pd(d.v, v);
+#else
+	_mm_storeu_pd(d.v, v.xy);
+	_mm_storeu_pd(d.v + 2, v.zw);
+#endif
+	return d;
+}
+
+/**
+ * @brief Reduces the comparison of `a == b` to an integer scalar.
+ * @return True if @p a is equal to @p b, false otherwise.
+ */
+static int dvec_equal(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)) == 0xF;
+#else
+	return (_mm_movemask_pd(_mm_cmpeq_pd(a.xy, b.xy)) & _mm_movemask_pd(_mm_cmpeq_pd(a.zw, b.zw))) == 0x3;
+#endif
+}
+
+/**
+ * @brief Calculates the length of @p v.
+ * @return A vector `(l, 0, 0, 0)`, where `l` is the length of @p v.
+ */
+static dvec dvec_length(const dvec v) {
+	return dvec_sqrt(dvec_dot3(v, v));
+}
+
+/**
+ * @brief Calculates the component-wise maximum of @p a and @p b.
+ * @return A vector containing the component-wise maximum of @p a and @p b.
+ */
+static dvec dvec_max(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_max_pd(a, b);
+#else
+	return (dvec) { _mm_max_pd(a.xy, b.xy), _mm_max_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @brief Calculates the component-wise minimum of @p a and @p b.
+ * @return A vector containing the component-wise minimum of @p a and @p b.
+ */
+static dvec dvec_min(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_min_pd(a, b);
+#else
+	return (dvec) { _mm_min_pd(a.xy, b.xy), _mm_min_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @brief Linearly interpolates between vectors @p a and @p b.
+ * @return A vector equal to `a * (1 - mix) + b * mix`.
+ */
+static dvec dvec_mix(const dvec a, const dvec b, double mix) {
+	return dvec_multiply_add(b, dvec_new(mix), dvec_scale(a, 1 - mix));
+}
+
+/**
+ * @brief Calculates the product of @p a `*` @p b.
+ * @return A vector containing the product of @p a `*` @p b.
+ */
+static dvec dvec_multiply(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_mul_pd(a, b);
+#else
+	return (dvec) { _mm_mul_pd(a.xy, b.xy), _mm_mul_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @brief Calculates the sum of the product @p a `*` @p b and @p c.
+ * @details Where QUEMATH_HAS_FMA is set, the product is not rounded before the sum.
+ * @return A vector containing @p a `*` @p b `+` @p c.
+ */
+static dvec dvec_multiply_add(const dvec a, const dvec b, const dvec c) {
+#if QUEMATH_HAS_FMA && defined(__AVX2__)
+	return _mm256_fmadd_pd(a, b, c);
+#elif QUEMATH_HAS_FMA
+	return (dvec) { _mm_fmadd_pd(a.xy, b.xy, c.xy), _mm_fmadd_pd(a.zw, b.zw, c.zw) };
+#else
+	return dvec_add(dvec_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Returns the negated value of @p v.
+ * @return A vector containing the negated value of @p v.
+ */
+static dvec dvec_negate(const dvec v) {
+	return dvec_subtract(dvec0(), v);
+}
+
+/**
+ * @brief Creates a vector with all components set to @p d.
+ * @return A vector with all components set to @p d.
+ */
+static dvec dvec_new(double d) {
+#if defined(__AVX2__)
+	return _mm256_set1_pd(d);
+#else
+	return (dvec) { _mm_set1_pd(d), _mm_set1_pd(d) };
+#endif
+}
+
+/**
+ * @brief Calculates the unit length vector of @p v by the square root.
+ * @return A unit vector in the same direction of @p v.
+ */
+static dvec dvec_normalize(const dvec v) {
+	return dvec_scale(v, 1 / dvec_x(dvec_length(v)));
+}
+
+/**
+ * @brief Calculates the scalar product of @p v `*` @p scale.
+ * @return A vector containing the scalar product @p v `*` @p scale.
+ */
+static dvec dvec_scale(const dvec v, double scale) {
+	return dvec_multiply(v, dvec_new(scale));
+}
+
+/**
+ * @brief Calculates the sum of @p a and the scalar product @p b `*` @p scale.
+ * @return A vector containing the sum of @p a and the scalar product @p b `*` @p scale.
+ */
+static dvec dvec_scale_add(const dvec a, const dvec b, double scale) {
+	return dvec_multiply_add(b, dvec_new(scale), a);
+}
+
+/**
+ * @brief Calculates the square root of @p v.
+ * @return A vector containing the square root of @p v.
+ */
+static dvec dvec_sqrt(const dvec v) {
+#if defined(__AVX2__)
+	return _mm256_sqrt_pd(v);
+#else
+	return (dvec) { _mm_sqrt_pd(v.xy), _mm_sqrt_pd(v.zw) };
+#endif
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ * @return A vector containing the difference of @p a `-` @p b.
+ */
+static dvec dvec_subtract(const dvec a, const dvec b) {
+#if defined(__AVX2__)
+	return _mm256_sub_pd(a, b);
+#else
+	return (dvec) { _mm_sub_pd(a.xy, b.xy), _mm_sub_pd(a.zw, b.zw) };
+#endif
+}
+
+/**
+ * @return The `w` component of @p v.
+ */
+static double dvec_w(const dvec v) {
+	return dvec_dvec4(v).w;
+}
+
+/**
+ * @return The `x` component of @p v.
+ */
+static double dvec_x(const dvec v) {
+#if defined(__AVX2__)
+	return _mm256_cvtsd_f64(v);
+#else
+	return _mm_cvtsd_f64(v.xy);
+#endif
+}
+
+/**
+ * @return The `y` component of @p v.
+ */
+static double dvec_y(const dvec v) {
+	return dvec_dvec4(v).y;
+}
+
+/**
+ * @brief Swizzles @p v to `(y, z, x, w)`.
+ * @return A vector with the components `(y, z, x, w)` of @p v.
+ */
+static dvec dvec_yzx(const dvec v) {
+#if defined(__AVX2__)
+	return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 0, 2, 1));
+#else
+	return (dvec) { _mm_shuffle_pd(v.xy, v.zw, 0x1), _mm_shuffle_pd(v.xy, v.zw, 0x2) };
+#endif
+}
+
+/**
+ * @return The `z` component of @p v.
+ */
+static double dvec_z(const dvec v) {
+	return dvec_dvec4(v).z;
+}
+
+/**
+ * @brief Swizzles @p v to `(z, x, y, w)`.
+ * @return A vector with the components `(z, x, y, w)` of @p v.
+ */
+static dvec dvec_zxy(const dvec v) {
+#if defined(__AVX2__)
+	return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 1, 0, 2));
+#else
+	return (dvec) { _mm_shuffle_pd(v.zw, v.xy, 0x0), _mm_shuffle_pd(v.xy, v.zw, 0x3) };
+#endif
+}
+
+/**
+ * @brief Converts the double precision vector @p v to single precision, rounding to nearest.
+ * @return A single precision vector nearest to @p v.
+ */
+static vec vec_convert_dvec(const dvec v) {
+#if defined(__AVX2__)
+	return _mm256_cvtpd_ps(v);
+#else
+	return _mm_movelh_ps(_mm_cvtpd_ps(v.xy), _mm_cvtpd_ps(v.zw));
+#endif
+}
+
+/**
+ * @brief Converts the point @p v to single precision, relative to @p origin.
+ * @details The difference is taken in double precision, so that only its rounding to single
+ * precision is lost, however far @p v and @p origin are from the world origin.
+ * @return A single precision vector nearest to @p v `-` @p origin.
+ */
+static vec vec_convert_dvec_relative(const dvec v, const dvec origin) {
+	return vec_convert_dvec(dvec_subtract(v, origin));
+}
+
+/**
+ * @brief Converts @p count points to single precision, relative to @p origin.
+ * @details Runs four at a time, with AVX2 where it is supported. Typically, @p origin is the
+ * camera position, so that the points are ready to be transformed by a camera-relative view.
+ * @param out The output array of camera-relative points.
+ * @param in The input array of world points.
+ * @see vec_convert_dvec_relative
+ */
+static void vec3_convert_dvec3_relative_array(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count) {
+
+#if QUEMATH_AVX2
+	if (count >= 4 && cpu_has_avx2()) {
+		vec3_convert_dvec3_relative_array_avx2(out, in, origin, count);
+		return;
+	}
+#endif
+
+	vec3_convert_dvec3_relative_array_sse(out, in, origin, count);
+}
+
+/**
+ * @brief Converts @p count points to single precision, relative to @p origin, four at a time.
+ * @details The packed `xyz` layouts of dvec3 and vec3 line up, so that each pair of loads is
+ * subtracted from a repeating pattern of @p origin, converted, and stored without shuffling.
+ * @see vec3_convert_dvec3_relative_array
+ */
+static void vec3_convert_dvec3_relative_array_sse(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count) {
+	const __m128d xy = _mm_setr_pd(origin.x, origin.y);
+	const __m128d zx = _mm_setr_pd(origin.z, origin.x);
+	const __m128d yz = _mm_setr_pd(origin.y, origin.z);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const double *d = in[i].v;
+		float *f = out[i].v;
+
+		_mm_storeu_ps(f + 0, _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 0), xy)),
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 2), zx))));
+		_mm_storeu_ps(f + 4, _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 4), yz)),
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 6), xy))));
+		_mm_storeu_ps(f + 8, _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 8), zx)),
+			_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(d + 10), yz))));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_convert_dvec_relative(dvec3fv(in[i]), dvec3fv(origin)));
+	}
+}
+
+#if QUEMATH_AVX2
+
+/**
+ * @brief Converts @p count points to single precision, relative to @p origin, with AVX2.
+ * @see vec3_convert_dvec3_relative_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_convert_dvec3_relative_array_avx2(vec3 *out, const dvec3 *in, const dvec3 origin, size_t count) {
+	const __m256d xyzx = _mm256_setr_pd(origin.x, origin.y, origin.z, origin.x);
+	const __m256d yzxy = _mm256_setr_pd(origin.y, origin.z, origin.x, origin.y);
+	const __m256d zxyz = _mm256_setr_pd(origin.z, origin.x, origin.y, origin.z);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const double *d = in[i].v;
+		float *f = out[i].v;
+
+		_mm_storeu_ps(f + 0, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(d + 0), xyzx)));
+		_mm_storeu_ps(f + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(d + 4), yzxy)));
+		_mm_storeu_ps(f + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(d + 8), zxyz)));
+	}
+	vec3_convert_dvec3_relative_array_sse(out + batch, in + batch, origin, count - batch);
+}
+
+#endif
+
+/** @} */
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <math.h>
+#include <stdint.h>
 #include <x86intrin.h>
 
 /**
@@ -52,6 +53,69 @@ typedef int ivec4[4];
  */
 typedef __m128i ivec;
 
+/**
+ * @brief A signed divisor, with its magic numbers precomputed for division by multiplication.
+ * @details Dividing many vectors by the same divisor with ivec_divide costs a multiply and a few
+ * shifts, rather than four scalar divisions. Powers of two are divided by shifts alone.
+ */
+typedef struct {
+	/**
+	 * @brief The divisor, in all four components.
+	 */
+	ivec divisor;
+
+	/**
+	 * @brief The magic multiplier, in all four components.
+	 */
+	ivec magic;
+
+	/**
+	 * @brief `1` or `-1` to add or subtract the dividend from the high product, or `0`.
+	 */
+	ivec add;
+
+	/**
+	 * @brief The shift applied to the high product, or the power of two, in the low 64 bits.
+	 */
+	ivec shift;
+
+	/**
+	 * @brief The shift that rounds negative dividends toward zero for powers of two.
+	 */
+	ivec bias;
+
+	/**
+	 * @brief The sign of the divisor if its magnitude is a power of two, otherwise `0`.
+	 */
+	int power_of_two;
+} ivec_divisor;
+
+/**
+ * @brief An unsigned divisor, with its magic numbers precomputed for division by multiplication.
+ * @see ivec_divisor
+ */
+typedef struct {
+	/**
+	 * @brief The divisor, in all four components.
+	 */
+	ivec divisor;
+
+	/**
+	 * @brief The magic multiplier, in all four components.
+	 */
+	ivec magic;
+
+	/**
+	 * @brief The shifts applied before and after adding the high product, in the low 64 bits.
+	 */
+	ivec shift1, shift2;
+
+	/**
+	 * @brief Non-zero if the divisor is a power of two.
+	 */
+	int power_of_two;
+} ivec_divisor_unsigned;
+
 static inline ivec ivec0(void);
 static inline ivec ivec1i(int x);
 static inline ivec ivec2i(int x, int y);
@@ -62,24 +126,47 @@ static inline ivec ivec4i(int x, int y, int z, int w);
 static inline ivec ivec4iv(const ivec4 i);
 static inline ivec ivec_abs(const ivec v);
 static inline ivec ivec_add(const ivec a, const ivec b);
+static inline ivec ivec_and(const ivec a, const ivec b);
+static inline ivec ivec_andnot(const ivec a, const ivec b);
+static inline ivec ivec_blend(const ivec a, const ivec b, const ivec mask);
 static inline ivec ivec_compare_eq(const ivec a, const ivec b);
 static inline ivec ivec_compare_gt(const ivec a, const ivec b);
 static inline ivec ivec_compare_lt(const ivec a, const ivec b);
+static inline ivec ivec_divide(const ivec a, const ivec_divisor d);
+static inline ivec ivec_divide_unsigned(const ivec a, const ivec_divisor_unsigned d);
+static inline ivec_divisor ivec_divisor_new(int32_t d);
+static inline ivec_divisor_unsigned ivec_divisor_unsigned_new(uint32_t d);
 static inline int ivec_equals(const ivec a, const ivec b);
 static inline ivec ivec_false(void);
+static inline ivec ivec_floor_divide(const ivec a, const ivec_divisor d);
+static inline ivec ivec_floor_modulo(const ivec a, const ivec_divisor d);
 static inline int ivec_greater_than(const ivec a, const ivec b);
+static inline ivec ivec_horizontal_max(const ivec v);
+static inline ivec ivec_horizontal_min(const ivec v);
 static inline int ivec_less_than(const ivec a, const ivec b);
 static inline ivec ivec_max(const ivec a, const ivec b);
 static inline ivec ivec_min(const ivec a, const ivec b);
 static inline ivec ivec_modulo(const ivec a, const ivec b);
 static inline ivec ivec_multiply(const ivec a, const ivec b);
+static inline ivec ivec_multiply_high(const ivec a, const ivec b);
+static inline ivec ivec_multiply_high_unsigned(const ivec a, const ivec b);
 static inline ivec ivec_new(int i);
+static inline ivec ivec_or(const ivec a, const ivec b);
 static inline ivec ivec_random(ivec last);
 static inline ivec ivec_random_range(ivec last, ivec mins, ivec maxs);
+static inline ivec ivec_remainder(const ivec a, const ivec_divisor d);
+static inline ivec ivec_remainder_unsigned(const ivec a, const ivec_divisor_unsigned d);
+static inline ivec ivec_shift_left(const ivec v, int bits);
+static inline ivec ivec_shift_left_variable(const ivec v, const ivec bits);
+static inline ivec ivec_shift_right(const ivec v, int bits);
+static inline ivec ivec_shift_right_logical(const ivec v, int bits);
+static inline ivec ivec_shift_right_logical_variable(const ivec v, const ivec bits);
+static inline ivec ivec_shift_right_variable(const ivec v, const ivec bits);
 static inline ivec ivec_subtract(const ivec a, const ivec b);
 static inline ivec ivec_true(void);
 static inline int ivec_w(const ivec v);
 static inline int ivec_x(const ivec v);
+static inline ivec ivec_xor(const ivec a, const ivec b);
 static inline int ivec_y(const ivec v);
 static inline int ivec_z(const ivec v);
 
@@ -163,6 +250,32 @@ static ivec ivec_add(const ivec a, const ivec b) {
 	return _mm_add_epi32(a, b);
 }
 
+/**
+ * @brief Calculates the bitwise and of @p a `&` @p b.
+ * @return An integer vector containing the bitwise and of @p a `&` @p b.
+ */
+static ivec ivec_and(const ivec a, const ivec b) {
+	return _mm_and_si128(a, b);
+}
+
+/**
+ * @brief Calculates the bitwise and of `~`@p a `&` @p b.
+ * @details Note that, as with the underlying instruction, it is the first operand that is inverted.
+ * @return An integer vector containing the bitwise and of `~`@p a `&` @p b.
+ */
+static ivec ivec_andnot(const ivec a, const ivec b) {
+	return _mm_andnot_si128(a, b);
+}
+
+/**
+ * @brief Selects the components of @p b where @p mask is true, and of @p a elsewhere.
+ * @param mask A comparison result, with each component `0xFFFFFFFF` or `0x0`.
+ * @return An integer vector blending @p a and @p b by @p mask.
+ */
+static ivec ivec_blend(const ivec a, const ivec b, const ivec mask) {
+	return _mm_blendv_epi8(a, b, mask);
+}
+
 /**
  * @brief Compares each component of the two integer vectors, testing `a[i] == b[i]`.
  * @details The comparison yields `0xFFFFFFFF` for true and `0x0` for false.
@@ -190,6 +303,122 @@ static ivec ivec_compare_lt(const ivec a, const ivec b) {
 	return _mm_cmplt_epi32(a, b);
 }
 
+/**
+ * @brief Divides @p a by the invariant divisor @p d, rounding toward zero as C does.
+ * @return An integer vector containing the quotients of @p a `/` @p d.
+ */
+static ivec ivec_divide(const ivec a, const ivec_divisor d) {
+
+	if (d.power_of_two) {
+		const ivec bias = _mm_srl_epi32(_mm_srai_epi32(a, 31), d.bias);
+		return _mm_sign_epi32(_mm_sra_epi32(_mm_add_epi32(a, bias), d.shift), d.divisor);
+	}
+
+	ivec q = _mm_add_epi32(ivec_multiply_high(a, d.magic), _mm_sign_epi32(a, d.add));
+	q = _mm_sra_epi32(q, d.shift);
+	return _mm_add_epi32(q, _mm_srli_epi32(q, 31));
+}
+
+/**
+ * @brief Divides the unsigned components of @p a by the invariant divisor @p d.
+ * @return An integer vector containing the unsigned quotients of @p a `/` @p d.
+ */
+static ivec ivec_divide_unsigned(const ivec a, const ivec_divisor_unsigned d) {
+
+	if (d.power_of_two) {
+		return _mm_srl_epi32(a, d.shift2);
+	}
+
+	const ivec t = ivec_multiply_high_unsigned(a, d.magic);
+	return _mm_srl_epi32(_mm_add_epi32(t, _mm_srl_epi32(_mm_sub_epi32(a, t), d.shift1)), d.shift2);
+}
+
+/**
+ * @brief Precomputes the magic numbers for dividing by @p d, after Granlund and Montgomery.
+ * @param d The divisor, which must not be `0`.
+ * @return The invariant divisor.
+ */
+static ivec_divisor ivec_divisor_new(int32_t d) {
+
+	const uint32_t ad = d < 0 ? 0u - (uint32_t) d : (uint32_t) d;
+
+	ivec_divisor divisor = {
+		.divisor = _mm_set1_epi32(d),
+		.power_of_two = (ad & (ad - 1)) == 0 ? (d < 0 ? -1 : 1) : 0
+	};
+
+	if (divisor.power_of_two) {
+		const int k = __builtin_ctz(ad);
+		divisor.shift = _mm_cvtsi32_si128(k);
+		divisor.bias = _mm_cvtsi32_si128(32 - k);
+		return divisor;
+	}
+
+	// Hacker's Delight, 10-1
+	const uint32_t t = 0x80000000u + ((uint32_t) d >> 31);
+	const uint32_t anc = t - 1 - t % ad;
+
+	int p = 31;
+	uint32_t q1 = 0x80000000u / anc, r1 = 0x80000000u - q1 * anc;
+	uint32_t q2 = 0x80000000u / ad, r2 = 0x80000000u - q2 * ad;
+	uint32_t delta;
+
+	do {
+		p++;
+		q1 <<= 1;
+		r1 <<= 1;
+		if (r1 >= anc) {
+			q1++;
+			r1 -= anc;
+		}
+		q2 <<= 1;
+		r2 <<= 1;
+		if (r2 >= ad) {
+			q2++;
+			r2 -= ad;
+		}
+		delta = ad - r2;
+	} while (q1 < delta || (q1 == delta && r1 == 0));
+
+	int32_t magic = (int32_t) (q2 + 1);
+	if (d < 0) {
+		magic = (int32_t) (0u - (uint32_t) magic);
+	}
+
+	divisor.magic = _mm_set1_epi32(magic);
+	divisor.add = _mm_set1_epi32(d > 0 && magic < 0 ? 1 : d < 0 && magic > 0 ? -1 : 0);
+	divisor.shift = _mm_cvtsi32_si128(p - 32);
+
+	return divisor;
+}
+
+/**
+ * @brief Precomputes the magic numbers for unsigned division by @p d, after Granlund and Montgomery.
+ * @param d The divisor, which must not be `0`.
+ * @return The invariant divisor.
+ */
+static ivec_divisor_unsigned ivec_divisor_unsigned_new(uint32_t d) {
+
+	ivec_divisor_unsigned divisor = {
+		.divisor = _mm_set1_epi32((int) d),
+		.power_of_two = (d & (d - 1)) == 0
+	};
+
+	if (divisor.power_of_two) {
+		divisor.shift2 = _mm_cvtsi32_si128(__builtin_ctz(d));
+		return divisor;
+	}
+
+	// the quotient is ((n - t) >> 1 + t) >> (l - 1), where t is the high product and l = ceil(log2(d))
+	const int l = 32 - __builtin_clz(d - 1);
+
+	divisor.magic = _mm_set1_epi32((int) (uint32_t) ((((1ull << l) - d) << 32) / d + 1));
+	divisor.shift1 = _mm_cvtsi32_si128(1);
+	divisor.shift2 = _mm_cvtsi32_si128(l - 1);
+
+	return divisor;
+}
+
 /**
  * @brief Creates an integer vector with all four components initialied to false (`0x0`).
  * @return An integer vector with all four components initialized to false (`0x0`).
@@ -198,6 +427,42 @@ static ivec ivec_false(void) {
 	return _mm_setzero_si128();
 }
 
+/**
+ * @brief Divides @p a by the invariant divisor @p d, rounding toward negative infinity.
+ * @details This is the quotient to use for addressing grid cells, as `-1 / 16` is `-1` rather than `0`.
+ * @return An integer vector containing the floored quotients of @p a `/` @p d.
+ */
+static ivec ivec_floor_divide(const ivec a, const ivec_divisor d) {
+
+	if (d.power_of_two > 0) {
+		return _mm_sra_epi32(a, d.shift);
+	}
+
+	const ivec q = ivec_divide(a, d);
+	const ivec r = _mm_sub_epi32(a, ivec_multiply(q, d.divisor));
+
+	// step down where the remainder is non-zero and its sign differs from the divisor's
+	const ivec adjust = _mm_andnot_si128(_mm_cmpeq_epi32(r, ivec0()), _mm_srai_epi32(_mm_xor_si128(r, d.divisor), 31));
+	return _mm_add_epi32(q, adjust);
+}
+
+/**
+ * @brief Calculates @p a modulo the invariant divisor @p d, taking the sign of the divisor.
+ * @details This is the offset to use within grid cells, as `-1 mod 16` is `15` rather than `-1`.
+ * @return An integer vector containing the floored moduli of @p a by @p d.
+ */
+static ivec ivec_floor_modulo(const ivec a, const ivec_divisor d) {
+
+	if (d.power_of_two > 0) {
+		return _mm_and_si128(a, _mm_sub_epi32(d.divisor, _mm_set1_epi32(1)));
+	}
+
+	const ivec r = ivec_remainder(a, d);
+
+	const ivec adjust = _mm_andnot_si128(_mm_cmpeq_epi32(r, ivec0()), _mm_srai_epi32(_mm_xor_si128(r, d.divisor), 31));
+	return _mm_add_epi32(r, _mm_and_si128(adjust, d.divisor));
+}
+
 /**
  * @brief Reduces the comparison of `a == b` to an integer scalar.
  * @return True if @p a is equal to @p b, false otherwise.
@@ -214,6 +479,24 @@ static int ivec_greater_than(const ivec a, const ivec b) {
 	return _mm_testc_si128(ivec_compare_gt(a, b), ivec_true());
 }
 
+/**
+ * @brief Calculates the maximum of the four components of @p v.
+ * @return An integer vector with the maximum component of @p v in all four components.
+ */
+static ivec ivec_horizontal_max(const ivec v) {
+	const ivec m = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+/**
+ * @brief Calculates the minimum of the four components of @p v.
+ * @return An integer vector with the minimum component of @p v in all four components.
+ */
+static ivec ivec_horizontal_min(const ivec v) {
+	const ivec m = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_min_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
 /**
  * @brief Reduces the comparison of `a < b` to an integer scalar.
  * @return True if @p a is less than @p b, false otherwise.
@@ -240,6 +523,7 @@ static ivec ivec_min(const ivec a, const ivec b) {
 
 /**
  * @brief Calculates the integer modulo of @p a `%` @p b.
+ * @details This is evaluated one component at a time. Prefer ivec_remainder for invariant divisors.
  * @return An integer vector containing the modulo of @p a `%` @p b.
  */
 static ivec ivec_modulo(const ivec a, const ivec b) {
@@ -251,10 +535,31 @@ static ivec ivec_modulo(const ivec a, const ivec b) {
 
 /**
  * @brief Calculates the product of @p a `*` @p b.
+ * @details Products wrap to their low 32 bits, as in C. Use ivec_multiply_high for the high bits.
  * @return An integer vector containing the product of @p a `*` @p b.
  */
 static ivec ivec_multiply(const ivec a, const ivec b) {
-	return _mm_mul_epi32(a, b);
+	return _mm_mullo_epi32(a, b);
+}
+
+/**
+ * @brief Calculates the upper 32 bits of the 64 bit signed products of @p a `*` @p b.
+ * @return An integer vector containing the high halves of the signed products of @p a `*` @p b.
+ */
+static ivec ivec_multiply_high(const ivec a, const ivec b) {
+	const ivec even = _mm_mul_epi32(a, b);
+	const ivec odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xcc);
+}
+
+/**
+ * @brief Calculates the upper 32 bits of the 64 bit unsigned products of @p a `*` @p b.
+ * @return An integer vector containing the high halves of the unsigned products of @p a `*` @p b.
+ */
+static ivec ivec_multiply_high_unsigned(const ivec a, const ivec b) {
+	const ivec even = _mm_mul_epu32(a, b);
+	const ivec odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xcc);
 }
 
 /**
@@ -265,8 +570,17 @@ static ivec ivec_new(int i) {
 	return _mm_set1_epi32(i);
 }
 
+/**
+ * @brief Calculates the bitwise or of @p a `|` @p b.
+ * @return An integer vector containing the bitwise or of @p a `|` @p b.
+ */
+static ivec ivec_or(const ivec a, const ivec b) {
+	return _mm_or_si128(a, b);
+}
+
 /**
  * @brief Generates a four component vector of random integers using _Xorshift_.
+ * @details The lanes are not independent streams. Prefer random4 for bulk generation.
  * @param last The last returned random integer vector, or a non-zero seed value.
  * @return An integer vector containing four psuedo-random numbers between `0` and `RAND_MAX`.
  */
@@ -280,13 +594,116 @@ static ivec ivec_random(ivec last) {
 
 /**
  * @brief Generates a four component vector of random integers using _Xorshift_.
+ * @details The random bits are mapped onto the range with a multiply rather than a modulo,
+ * after Lemire. Prefer random4_next_range for independent streams and an unbiased mode.
  * @param last The last returned random integer vector, or a non-zero seed value.
  * @param mins The lower bounds of the returned integers (inclusive).
  * @param maxs The upper bounds of the returned integers (exclusive).
  * @return An integer vector containing four psuedo-random numbers between @p mins and @p maxs.
  */
 static ivec ivec_random_range(ivec last, ivec mins, ivec maxs) {
-	return ivec_add(mins, ivec_modulo(ivec_random(last), ivec_subtract(maxs, mins)));
+
+	// scale the RAND_MAX bits of ivec_random to fill all 32 bits
+	const ivec scale = ivec_new((int) (0x100000000ull / ((unsigned long long) RAND_MAX + 1)));
+	const ivec bits = ivec_multiply(ivec_random(last), scale);
+
+	return ivec_add(mins, ivec_multiply_high_unsigned(bits, ivec_subtract(maxs, mins)));
+}
+
+/**
+ * @brief Calculates the remainder of @p a divided by the invariant divisor @p d, as C's `%`.
+ * @return An integer vector containing the remainders of @p a `%` @p d, taking the sign of @p a.
+ */
+static ivec ivec_remainder(const ivec a, const ivec_divisor d) {
+	return _mm_sub_epi32(a, ivec_multiply(ivec_divide(a, d), d.divisor));
+}
+
+/**
+ * @brief Calculates the remainder of the unsigned components of @p a divided by @p d.
+ * @return An integer vector containing the unsigned remainders of @p a `%` @p d.
+ */
+static ivec ivec_remainder_unsigned(const ivec a, const ivec_divisor_unsigned d) {
+
+	if (d.power_of_two) {
+		return _mm_and_si128(a, _mm_sub_epi32(d.divisor, _mm_set1_epi32(1)));
+	}
+
+	return _mm_sub_epi32(a, ivec_multiply(ivec_divide_unsigned(a, d), d.divisor));
+}
+
+/**
+ * @brief Shifts each component of @p v left by @p bits.
+ * @details Constant shifts compile to the immediate form of the instruction.
+ * @return An integer vector containing @p v `<<` @p bits, or `0` where @p bits exceeds `31`.
+ */
+static ivec ivec_shift_left(const ivec v, int bits) {
+	return _mm_sll_epi32(v, _mm_cvtsi32_si128(bits));
+}
+
+/**
+ * @brief Shifts each component of @p v left by the corresponding component of @p bits.
+ * @details Without AVX2, the shift is a multiply by a power of two, built in the exponent of a float.
+ * @return An integer vector containing @p v `<<` @p bits, or `0` where @p bits exceeds `31`.
+ */
+static ivec ivec_shift_left_variable(const ivec v, const ivec bits) {
+#if defined(__AVX2__)
+	return _mm_sllv_epi32(v, bits);
+#else
+	const ivec exponent = _mm_add_epi32(_mm_slli_epi32(bits, 23), _mm_set1_epi32(0x3f800000));
+	const ivec power = _mm_cvttps_epi32(_mm_castsi128_ps(exponent));
+	const ivec valid = _mm_cmpeq_epi32(_mm_srli_epi32(bits, 5), ivec0());
+	return _mm_and_si128(_mm_mullo_epi32(v, power), valid);
+#endif
+}
+
+/**
+ * @brief Shifts each component of @p v right by @p bits, extending the sign bit.
+ * @return An integer vector containing @p v `>>` @p bits.
+ */
+static ivec ivec_shift_right(const ivec v, int bits) {
+	return _mm_sra_epi32(v, _mm_cvtsi32_si128(bits));
+}
+
+/**
+ * @brief Shifts each component of @p v right by @p bits, filling with zeros.
+ * @return An integer vector containing the unsigned @p v `>>` @p bits.
+ */
+static ivec ivec_shift_right_logical(const ivec v, int bits) {
+	return _mm_srl_epi32(v, _mm_cvtsi32_si128(bits));
+}
+
+/**
+ * @brief Shifts each component of @p v right by the corresponding component of @p bits, filling with zeros.
+ * @details Without AVX2, each lane is shifted separately and the results blended.
+ * @return An integer vector containing the unsigned @p v `>>` @p bits, or `0` where @p bits exceeds `31`.
+ */
+static ivec ivec_shift_right_logical_variable(const ivec v, const ivec bits) {
+#if defined(__AVX2__)
+	return _mm_srlv_epi32(v, bits);
+#else
+	const ivec x = _mm_srl_epi32(v, _mm_and_si128(bits, _mm_set_epi32(0, 0, 0, -1)));
+	const ivec y = _mm_srl_epi32(v, _mm_srli_epi64(_mm_move_epi64(bits), 32));
+	const ivec z = _mm_srl_epi32(v, _mm_and_si128(_mm_srli_si128(bits, 8), _mm_set_epi32(0, 0, 0, -1)));
+	const ivec w = _mm_srl_epi32(v, _mm_srli_si128(bits, 12));
+	return _mm_blend_epi16(_mm_blend_epi16(x, y, 0x0c), _mm_blend_epi16(z, w, 0xc0), 0xf0);
+#endif
+}
+
+/**
+ * @brief Shifts each component of @p v right by the corresponding component of @p bits, extending the sign bit.
+ * @details Without AVX2, each lane is shifted separately and the results blended.
+ * @return An integer vector containing @p v `>>` @p bits, or the sign where @p bits exceeds `31`.
+ */
+static ivec ivec_shift_right_variable(const ivec v, const ivec bits) {
+#if defined(__AVX2__)
+	return _mm_srav_epi32(v, bits);
+#else
+	const ivec x = _mm_sra_epi32(v, _mm_and_si128(bits, _mm_set_epi32(0, 0, 0, -1)));
+	const ivec y = _mm_sra_epi32(v, _mm_srli_epi64(_mm_move_epi64(bits), 32));
+	const ivec z = _mm_sra_epi32(v, _mm_and_si128(_mm_srli_si128(bits, 8), _mm_set_epi32(0, 0, 0, -1)));
+	const ivec w = _mm_sra_epi32(v, _mm_srli_si128(bits, 12));
+	return _mm_blend_epi16(_mm_blend_epi16(x, y, 0x0c), _mm_blend_epi16(z, w, 0xc0), 0xf0);
+#endif
 }
 
 /**
@@ -320,6 +737,14 @@ static int ivec_x(const ivec v) {
 	return _mm_cvtsi128_si32(v);
 }
 
+/**
+ * @brief Calculates the bitwise exclusive or of @p a `^` @p b.
+ * @return An integer vector containing the bitwise exclusive or of @p a `^` @p b.
+ */
+static ivec ivec_xor(const ivec a, const ivec b) {
+	return _mm_xor_si128(a, b);
+}
+
 /**
  * @return The second component of the integer vector @p v.
  */
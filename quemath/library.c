@@ -0,0 +1,176 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "quemath.h"
+#include "library.h"
+
+/**
+ * @file
+ * @brief The compiled library, which binds each exported array kernel to its widest variant.
+ */
+
+#if defined(__ELF__) && defined(__GNUC__)
+ #define QUEMATH_IFUNC 1
+#else
+ #define QUEMATH_IFUNC 0
+#endif
+
+#if QUEMATH_AVX512
+ #define QUEMATH_RESOLVE_AVX512(name) if (cpu_has_avx512()) { return name##_avx512; }
+#else
+ #define QUEMATH_RESOLVE_AVX512(name)
+#endif
+
+#if QUEMATH_AVX2
+ #define QUEMATH_RESOLVE_AVX2(name) if (cpu_has_avx2()) { return name##_avx2; }
+#else
+ #define QUEMATH_RESOLVE_AVX2(name)
+#endif
+
+#if QUEMATH_F16C
+ #define QUEMATH_RESOLVE_F16C(name) if (cpu_has_f16c()) { return name##_f16c; }
+#else
+ #define QUEMATH_RESOLVE_F16C(name)
+#endif
+
+/**
+ * @brief Defines the indirect function resolver for the array kernel @p name.
+ * @details Resolvers run while the library is relocated, before any constructors, so the CPU
+ * model must be initialized here rather than relied upon.
+ */
+#define QUEMATH_RESOLVE(name) \
+	static __typeof__(name##_sse) *resolve_##name(void) { \
+		__builtin_cpu_init(); \
+		QUEMATH_RESOLVE_AVX512(name) \
+		QUEMATH_RESOLVE_AVX2(name) \
+		return name##_sse; \
+	}
+
+/**
+ * @brief Defines the indirect function resolver for the half precision conversion @p name.
+ */
+#define QUEMATH_RESOLVE_HALF(name) \
+	static __typeof__(name##_sse) *resolve_##name(void) { \
+		__builtin_cpu_init(); \
+		QUEMATH_RESOLVE_F16C(name) \
+		return name##_sse; \
+	}
+
+const char *quemath_isa(void) {
+
+#if QUEMATH_IFUNC
+	__builtin_cpu_init();
+#endif
+
+#if QUEMATH_AVX512
+	if (cpu_has_avx512()) {
+		return "avx512";
+	}
+#endif
+#if QUEMATH_AVX2
+	if (cpu_has_avx2()) {
+		return "avx2";
+	}
+#endif
+
+	return "sse4.1";
+}
+
+#if QUEMATH_IFUNC
+
+QUEMATH_RESOLVE_HALF(half_convert_vec_array)
+QUEMATH_RESOLVE(vec3_add_array)
+QUEMATH_RESOLVE(vec3_cross_array)
+QUEMATH_RESOLVE(vec3_distance_array)
+QUEMATH_RESOLVE(vec3_dot3_array)
+QUEMATH_RESOLVE(vec3_length_array)
+QUEMATH_RESOLVE(vec3_normalize_array)
+QUEMATH_RESOLVE(vec3_scale_add_array)
+QUEMATH_RESOLVE_HALF(vec_convert_half_array)
+
+void quemath_half_convert_vec_array(half *out, const float *in, size_t count)
+	__attribute__((ifunc("resolve_half_convert_vec_array")));
+
+void quemath_vec3_add_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count)
+	__attribute__((ifunc("resolve_vec3_add_array")));
+
+void quemath_vec3_cross_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count)
+	__attribute__((ifunc("resolve_vec3_cross_array")));
+
+void quemath_vec3_distance_array(float *out, const vec3 *a, const vec3 *b, size_t count)
+	__attribute__((ifunc("resolve_vec3_distance_array")));
+
+void quemath_vec3_dot3_array(float *out, const vec3 *a, const vec3 *b, size_t count)
+	__attribute__((ifunc("resolve_vec3_dot3_array")));
+
+void quemath_vec3_length_array(float *out, const vec3 *v, size_t count)
+	__attribute__((ifunc("resolve_vec3_length_array")));
+
+void quemath_vec3_normalize_array(vec3 *out, const vec3 *v, size_t count)
+	__attribute__((ifunc("resolve_vec3_normalize_array")));
+
+void quemath_vec3_scale_add_array(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count)
+	__attribute__((ifunc("resolve_vec3_scale_add_array")));
+
+void quemath_vec_convert_half_array(float *out, const half *in, size_t count)
+	__attribute__((ifunc("resolve_vec_convert_half_array")));
+
+#else
+
+void quemath_half_convert_vec_array(half *out, const float *in, size_t count) {
+	half_convert_vec_array(out, in, count);
+}
+
+void quemath_vec3_add_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	vec3_add_array(out, a, b, count);
+}
+
+void quemath_vec3_cross_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	vec3_cross_array(out, a, b, count);
+}
+
+void quemath_vec3_distance_array(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	vec3_distance_array(out, a, b, count);
+}
+
+void quemath_vec3_dot3_array(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	vec3_dot3_array(out, a, b, count);
+}
+
+void quemath_vec3_length_array(float *out, const vec3 *v, size_t count) {
+	vec3_length_array(out, v, count);
+}
+
+void quemath_vec3_normalize_array(vec3 *out, const vec3 *v, size_t count) {
+	vec3_normalize_array(out, v, count);
+}
+
+void quemath_vec3_scale_add_array(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) {
+	vec3_scale_add_array(out, a, b, scale, count);
+}
+
+void quemath_vec_convert_half_array(float *out, const half *in, size_t count) {
+	vec_convert_half_array(out, in, count);
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include "vec.h"
+
+/**
+ * @defgroup library library
+ * @brief Array kernels exported by the optional compiled library, `libquemath`.
+ * @details Configure with `--enable-library` to build and install `libquemath`. Each function
+ * below is bound once, when the library is loaded, to the SSE4.1, AVX2 or AVX-512 variant of the
+ * corresponding inline kernel in vec.h, by way of a GNU indirect function resolver. Calls then
+ * cost one indirect branch through the procedure linkage table, and no per call CPU checks.
+ * The half precision conversions are likewise bound to their SSE4.1 or F16C variant.
+ * Where indirect functions are not supported, as on Apple and MinGW hosts, each function instead
+ * calls its inline counterpart, which checks the CPU on every call.
+ * @remarks The inline headers remain the interface for everything else, and may be used
+ * alongside the library in the same translation unit.
+ * @{
+ */
+
+/**
+ * @see half_convert_vec_array
+ */
+extern void quemath_half_convert_vec_array(half *out, const float *in, size_t count);
+
+/**
+ * @return The instruction set the library has bound its kernels to, one of `"sse4.1"`, `"avx2"`
+ * or `"avx512"`.
+ */
+extern const char *quemath_isa(void);
+
+/**
+ * @see vec3_add_array
+ */
+extern void quemath_vec3_add_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+
+/**
+ * @see vec3_cross_array
+ */
+extern void quemath_vec3_cross_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+
+/**
+ * @see vec3_distance_array
+ */
+extern void quemath_vec3_distance_array(float *out, const vec3 *a, const vec3 *b, size_t count);
+
+/**
+ * @see vec3_dot3_array
+ */
+extern void quemath_vec3_dot3_array(float *out, const vec3 *a, const vec3 *b, size_t count);
+
+/**
+ * @see vec3_length_array
+ */
+extern void quemath_vec3_length_array(float *out, const vec3 *v, size_t count);
+
+/**
+ * @see vec3_normalize_array
+ */
+extern void quemath_vec3_normalize_array(vec3 *out, const vec3 *v, size_t count);
+
+/**
+ * @see vec3_scale_add_array
+ */
+extern void quemath_vec3_scale_add_array(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count);
+
+/**
+ * @see vec_convert_half_array
+ */
+extern void quemath_vec_convert_half_array(float *out, const half *in, size_t count);
+
+/** @} */
@@ -23,8 +23,16 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "quat.h"
 
+/**
+ * @defgroup mat mat
+ * @brief 4x4 floating point matrices.
+ * @{
+ */
+
 /**
  * @brief 4x4 Matrices.
  */
@@ -36,3 +44,698 @@ typedef struct {
 	vec a, b, c, d;
 
 } mat;
+
+/**
+ * @brief 3x4 affine matrices.
+ * @details The three rows hold the linear part in `x`, `y` and `z`, and the translation in `w`.
+ * The fourth row is implicitly `(0, 0, 0, 1)`.
+ */
+typedef struct {
+
+	/**
+	 * @brief Row accessors.
+	 */
+	vec x, y, z;
+
+} affine;
+
+/**
+ * @brief Flags for the array transform functions.
+ */
+typedef enum {
+	/**
+	 * @brief Write the output with non-temporal (streaming) stores, bypassing the cache.
+	 * @details Useful when the output is an upload buffer that will not be read back. Ignored
+	 * unless the output is 16 byte aligned.
+	 */
+	MAT_TRANSFORM_STREAM = 0x1
+} mat_transform_flags;
+
+static inline affine affine_columns(const vec x, const vec y, const vec z, const vec t);
+static inline affine affine_convert_mat(const mat m);
+static inline affine affine_convert_quat(const quat q);
+static inline void affine_convert_quat_array(vec4 *out, const quat *rotations, const vec *translations, size_t count);
+static inline affine affine_identity(void);
+static inline affine affine_inverse(const affine m);
+static inline affine affine_inverse_rigid(const affine m);
+static inline affine affine_multiply(const affine a, const affine b);
+static inline vec affine_transform_direction(const affine m, const vec v);
+static inline vec affine_transform_point(const affine m, const vec v);
+
+static inline vec mat2_adjugate_multiply(const vec a, const vec b);
+static inline vec mat2_multiply(const vec a, const vec b);
+static inline vec mat2_multiply_adjugate(const vec a, const vec b);
+
+static inline mat mat_convert_affine(const affine m);
+static inline mat mat_convert_quat(const quat q);
+static inline void mat_convert_quat_array(vec4 *out, const quat *rotations, const vec *translations, size_t count);
+static inline vec mat_determinant(const mat m);
+static inline int mat_equal(const mat a, const mat b);
+static inline mat mat_identity(void);
+static inline mat mat_inverse(const mat m);
+static inline mat mat_multiply(const mat a, const mat b);
+static inline mat mat_rotate(const vec axis, float angle);
+static inline mat mat_scale(const vec scale);
+static inline vec mat_transform(const mat m, const vec v);
+static inline vec mat_transform_direction(const mat m, const vec v);
+static inline void mat_transform_directions(const mat m, vec4 *out, const void *in, size_t stride, size_t count, int flags);
+static inline vec mat_transform_point(const mat m, const vec v);
+static inline void mat_transform_points(const mat m, vec4 *out, const void *in, size_t stride, size_t count, int flags);
+static inline mat mat_translate(const vec translation);
+static inline mat mat_transpose(const mat m);
+
+static inline quat quat_convert_mat(const mat m);
+static inline void quat_convert_mat_array(quat *out, const mat *m, size_t count);
+
+/**
+ * @brief Creates an affine matrix from the columns @p x, @p y and @p z of its linear part and
+ * its translation @p t.
+ * @details The `w` components of the arguments are ignored.
+ * @return The affine matrix.
+ */
+static affine affine_columns(const vec x, const vec y, const vec z, const vec t) {
+	const mat m = mat_transpose((mat) { x, y, z, t });
+	return (affine) { m.a, m.b, m.c };
+}
+
+/**
+ * @brief Converts the matrix @p m to an affine matrix, discarding its projective row.
+ * @return The affine matrix.
+ */
+static affine affine_convert_mat(const mat m) {
+	const mat t = mat_transpose(m);
+	return (affine) { t.a, t.b, t.c };
+}
+
+/**
+ * @brief Converts the unit quaternion @p q to an affine rotation matrix.
+ * @return The affine rotation matrix, with zero translation.
+ */
+static affine affine_convert_quat(const quat q) {
+	return affine_convert_mat(mat_convert_quat(q));
+}
+
+/**
+ * @brief Converts @p count rotations and translations to affine matrices, four at a time.
+ * @param out The output buffer of three rows per matrix, which need not be aligned, ready for upload.
+ * @param rotations The unit quaternions.
+ * @param translations The translations, or `NULL` for none.
+ */
+static void affine_convert_quat_array(vec4 *out, const quat *rotations, const vec *translations, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4, out += 12) {
+
+		vec3x4 a, b, c;
+		quatx4_columns(quatx4_load(rotations + i), &a, &b, &c);
+
+		const mat t = translations ?
+			mat_transpose((mat) { translations[i], translations[i + 1], translations[i + 2], translations[i + 3] }) :
+			(mat) { vec0(), vec0(), vec0(), vec0() };
+
+		const mat x = mat_transpose((mat) { a.x, b.x, c.x, t.a });
+		const mat y = mat_transpose((mat) { a.y, b.y, c.y, t.b });
+		const mat z = mat_transpose((mat) { a.z, b.z, c.z, t.c });
+
+		_mm_storeu_ps(out[0].v, x.a);
+		_mm_storeu_ps(out[1].v, y.a);
+		_mm_storeu_ps(out[2].v, z.a);
+		_mm_storeu_ps(out[3].v, x.b);
+		_mm_storeu_ps(out[4].v, y.b);
+		_mm_storeu_ps(out[5].v, z.b);
+		_mm_storeu_ps(out[6].v, x.c);
+		_mm_storeu_ps(out[7].v, y.c);
+		_mm_storeu_ps(out[8].v, z.c);
+		_mm_storeu_ps(out[9].v, x.d);
+		_mm_storeu_ps(out[10].v, y.d);
+		_mm_storeu_ps(out[11].v, z.d);
+	}
+	for (size_t i = batch; i < count; i++, out += 3) {
+		const affine m = affine_convert_quat(rotations[i]);
+		const vec t = translations ? translations[i] : vec0();
+
+		_mm_storeu_ps(out[0].v, _mm_blend_ps(m.x, _mm_shuffle_ps(t, t, 0x00), 0x8));
+		_mm_storeu_ps(out[1].v, _mm_blend_ps(m.y, _mm_shuffle_ps(t, t, 0x55), 0x8));
+		_mm_storeu_ps(out[2].v, _mm_blend_ps(m.z, _mm_shuffle_ps(t, t, 0xAA), 0x8));
+	}
+}
+
+/**
+ * @brief Creates the identity affine matrix.
+ * @return The identity affine matrix.
+ */
+static affine affine_identity(void) {
+	return (affine) {
+		vec4f(1, 0, 0, 0),
+		vec4f(0, 1, 0, 0),
+		vec4f(0, 0, 1, 0)
+	};
+}
+
+/**
+ * @brief Calculates the inverse of the affine matrix @p m.
+ * @details The linear part is inverted by cross products, and the translation by the inverted
+ * linear part. No test is made for singular matrices, which yield non-finite results.
+ * @return The inverse of the affine matrix @p m.
+ */
+static affine affine_inverse(const affine m) {
+
+	const vec yz = vec_cross(m.y, m.z);
+	const vec det = vec_dot3(m.x, yz);
+	const vec rcp = vec_divide(vec_new(1), _mm_shuffle_ps(det, det, 0x00));
+
+	// the columns of the inverted linear part
+	const vec a = vec_multiply(yz, rcp);
+	const vec b = vec_multiply(vec_cross(m.z, m.x), rcp);
+	const vec c = vec_multiply(vec_cross(m.x, m.y), rcp);
+
+	const vec t = vec_negate(vec_add(
+		vec_add(vec_multiply(a, _mm_shuffle_ps(m.x, m.x, 0xFF)), vec_multiply(b, _mm_shuffle_ps(m.y, m.y, 0xFF))),
+		vec_multiply(c, _mm_shuffle_ps(m.z, m.z, 0xFF))
+	));
+
+	return affine_columns(a, b, c, t);
+}
+
+/**
+ * @brief Calculates the inverse of the rigid affine matrix @p m.
+ * @details The linear part of @p m must be orthonormal (a rotation), so that its inverse is its
+ * transpose. This is considerably cheaper than affine_inverse.
+ * @return The inverse of the rigid affine matrix @p m.
+ */
+static affine affine_inverse_rigid(const affine m) {
+
+	const vec t = vec_negate(vec_add(
+		vec_add(vec_multiply(m.x, _mm_shuffle_ps(m.x, m.x, 0xFF)), vec_multiply(m.y, _mm_shuffle_ps(m.y, m.y, 0xFF))),
+		vec_multiply(m.z, _mm_shuffle_ps(m.z, m.z, 0xFF))
+	));
+
+	return affine_columns(m.x, m.y, m.z, t);
+}
+
+/**
+ * @brief Calculates the product of the affine matrices @p a `*` @p b.
+ * @return The product of the affine matrices @p a `*` @p b.
+ */
+static affine affine_multiply(const affine a, const affine b) {
+
+	const vec w = vec_cast_ivec(ivec4i(0, 0, 0, 0xFFFFFFFF));
+
+	#define AFFINE_MULTIPLY_ROW(r) vec_add( \
+		vec_add(vec_multiply(_mm_shuffle_ps(r, r, 0x00), b.x), vec_multiply(_mm_shuffle_ps(r, r, 0x55), b.y)), \
+		vec_add(vec_multiply(_mm_shuffle_ps(r, r, 0xAA), b.z), _mm_and_ps(r, w)) \
+	)
+
+	const affine m = {
+		AFFINE_MULTIPLY_ROW(a.x),
+		AFFINE_MULTIPLY_ROW(a.y),
+		AFFINE_MULTIPLY_ROW(a.z)
+	};
+
+	#undef AFFINE_MULTIPLY_ROW
+
+	return m;
+}
+
+/**
+ * @brief Transforms the direction @p v by the affine matrix @p m, ignoring translation.
+ * @return A vector `(x, y, z, 0)`, the product of @p m `*` `(v.x, v.y, v.z, 0)`.
+ */
+static vec affine_transform_direction(const affine m, const vec v) {
+	const vec p = vec_xyz(v);
+	return _mm_hadd_ps(
+		_mm_hadd_ps(vec_multiply(m.x, p), vec_multiply(m.y, p)),
+		_mm_hadd_ps(vec_multiply(m.z, p), vec0())
+	);
+}
+
+/**
+ * @brief Transforms the point @p v by the affine matrix @p m.
+ * @return A vector `(x, y, z, 0)`, the product of @p m `*` `(v.x, v.y, v.z, 1)`.
+ */
+static vec affine_transform_point(const affine m, const vec v) {
+	const vec p = _mm_blend_ps(v, vec_new(1), 0x8);
+	return _mm_hadd_ps(
+		_mm_hadd_ps(vec_multiply(m.x, p), vec_multiply(m.y, p)),
+		_mm_hadd_ps(vec_multiply(m.z, p), vec0())
+	);
+}
+
+/**
+ * @brief Calculates the product of the adjugate of the 2x2 matrix @p a and the 2x2 matrix @p b.
+ * @details 2x2 matrices are packed into a single vector as `(m00, m01, m10, m11)`.
+ * @return The 2x2 product `adj(a) * b`.
+ */
+static vec mat2_adjugate_multiply(const vec a, const vec b) {
+	return vec_subtract(
+		vec_multiply(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+		vec_multiply(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)))
+	);
+}
+
+/**
+ * @brief Calculates the product of the 2x2 matrices @p a and @p b.
+ * @details 2x2 matrices are packed into a single vector as `(m00, m01, m10, m11)`.
+ * @return The 2x2 product `a * b`.
+ */
+static vec mat2_multiply(const vec a, const vec b) {
+	return vec_add(
+		vec_multiply(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+		vec_multiply(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)))
+	);
+}
+
+/**
+ * @brief Calculates the product of the 2x2 matrix @p a and the adjugate of the 2x2 matrix @p b.
+ * @details 2x2 matrices are packed into a single vector as `(m00, m01, m10, m11)`.
+ * @return The 2x2 product `a * adj(b)`.
+ */
+static vec mat2_multiply_adjugate(const vec a, const vec b) {
+	return vec_subtract(
+		vec_multiply(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+		vec_multiply(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)))
+	);
+}
+
+/**
+ * @brief Converts the affine matrix @p m to a 4x4 matrix.
+ * @return The 4x4 matrix.
+ */
+static mat mat_convert_affine(const affine m) {
+	return mat_transpose((mat) { m.x, m.y, m.z, vec4f(0, 0, 0, 1) });
+}
+
+/**
+ * @brief Converts the unit quaternion @p q to a rotation matrix.
+ * @return The rotation matrix.
+ */
+static mat mat_convert_quat(const quat q) {
+
+	const vec q2 = vec_add(q, q);
+
+	// column i is e[i] + 2 * (a * b + c * d), with the signs of each product applied to b and d
+	const vec a0 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 0, 1)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 1, 1)), vec1f(-0.f)));
+	const vec c0 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 2)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 2, 2)), vec3f(-0.f, 0, -0.f)));
+
+	const vec a1 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 0)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 0, 1)), vec2f(0, -0.f)));
+	const vec c1 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 2, 3)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2)), vec2f(-0.f, -0.f)));
+
+	const vec a2 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 1, 0)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 2)), vec3f(0, 0, -0.f)));
+	const vec c2 = vec_multiply(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 3, 3)), _mm_xor_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 1, 0, 1)), vec3f(0, -0.f, -0.f)));
+
+	return (mat) {
+		vec_xyz(vec_add(vec1f(1), vec_add(a0, c0))),
+		vec_xyz(vec_add(vec2f(0, 1), vec_add(a1, c1))),
+		vec_xyz(vec_add(vec3f(0, 0, 1), vec_add(a2, c2))),
+		vec4f(0, 0, 0, 1)
+	};
+}
+
+/**
+ * @brief Converts @p count rotations and translations to 4x4 matrices, four at a time.
+ * @param out The output buffer of four columns per matrix, which need not be aligned, ready for upload.
+ * @param rotations The unit quaternions.
+ * @param translations The translations, or `NULL` for none.
+ */
+static void mat_convert_quat_array(vec4 *out, const quat *rotations, const vec *translations, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4, out += 16) {
+
+		vec3x4 a, b, c;
+		quatx4_columns(quatx4_load(rotations + i), &a, &b, &c);
+
+		const mat x = mat_transpose((mat) { a.x, a.y, a.z, vec0() });
+		const mat y = mat_transpose((mat) { b.x, b.y, b.z, vec0() });
+		const mat z = mat_transpose((mat) { c.x, c.y, c.z, vec0() });
+
+		const mat t = translations ?
+			(mat) { translations[i], translations[i + 1], translations[i + 2], translations[i + 3] } :
+			(mat) { vec0(), vec0(), vec0(), vec0() };
+
+		_mm_storeu_ps(out[0].v, x.a);
+		_mm_storeu_ps(out[1].v, y.a);
+		_mm_storeu_ps(out[2].v, z.a);
+		_mm_storeu_ps(out[3].v, _mm_blend_ps(t.a, vec_new(1), 0x8));
+		_mm_storeu_ps(out[4].v, x.b);
+		_mm_storeu_ps(out[5].v, y.b);
+		_mm_storeu_ps(out[6].v, z.b);
+		_mm_storeu_ps(out[7].v, _mm_blend_ps(t.b, vec_new(1), 0x8));
+		_mm_storeu_ps(out[8].v, x.c);
+		_mm_storeu_ps(out[9].v, y.c);
+		_mm_storeu_ps(out[10].v, z.c);
+		_mm_storeu_ps(out[11].v, _mm_blend_ps(t.c, vec_new(1), 0x8));
+		_mm_storeu_ps(out[12].v, x.d);
+		_mm_storeu_ps(out[13].v, y.d);
+		_mm_storeu_ps(out[14].v, z.d);
+		_mm_storeu_ps(out[15].v, _mm_blend_ps(t.d, vec_new(1), 0x8));
+	}
+	for (size_t i = batch; i < count; i++, out += 4) {
+		const mat m = mat_convert_quat(rotations[i]);
+		const vec t = translations ? translations[i] : vec0();
+
+		_mm_storeu_ps(out[0].v, m.a);
+		_mm_storeu_ps(out[1].v, m.b);
+		_mm_storeu_ps(out[2].v, m.c);
+		_mm_storeu_ps(out[3].v, _mm_blend_ps(t, vec_new(1), 0x8));
+	}
+}
+
+/**
+ * @brief Calculates the determinant of the matrix @p m.
+ * @return A vector `(d, d, d, d)`, where `d` is the determinant of @p m.
+ */
+static vec mat_determinant(const mat m) {
+
+	const vec A = _mm_movelh_ps(m.a, m.b);
+	const vec B = _mm_movehl_ps(m.b, m.a);
+	const vec C = _mm_movelh_ps(m.c, m.d);
+	const vec D = _mm_movehl_ps(m.d, m.c);
+
+	const vec det = vec_subtract(
+		vec_multiply(_mm_shuffle_ps(m.a, m.c, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(m.b, m.d, _MM_SHUFFLE(3, 1, 3, 1))),
+		vec_multiply(_mm_shuffle_ps(m.a, m.c, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(m.b, m.d, _MM_SHUFFLE(2, 0, 2, 0)))
+	);
+
+	const vec D_C = mat2_adjugate_multiply(D, C);
+	const vec A_B = mat2_adjugate_multiply(A, B);
+
+	vec tr = vec_multiply(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+	tr = _mm_hadd_ps(tr, tr);
+	tr = _mm_hadd_ps(tr, tr);
+
+	const vec ad = vec_multiply(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(0, 1, 2, 3)));
+	return vec_subtract(vec_add(_mm_shuffle_ps(ad, ad, 0x00), _mm_shuffle_ps(ad, ad, 0x55)), tr);
+}
+
+/**
+ * @brief Reduces the comparison of `a == b` to an integer scalar.
+ * @return True if all columns of @p a are equal to those of @p b, false otherwise.
+ */
+static int mat_equal(const mat a, const mat b) {
+	return vec_equal(a.a, b.a) && vec_equal(a.b, b.b) && vec_equal(a.c, b.c) && vec_equal(a.d, b.d);
+}
+
+/**
+ * @brief Creates the identity matrix.
+ * @return The identity matrix.
+ */
+static mat mat_identity(void) {
+	return (mat) {
+		vec4f(1, 0, 0, 0),
+		vec4f(0, 1, 0, 0),
+		vec4f(0, 0, 1, 0),
+		vec4f(0, 0, 0, 1)
+	};
+}
+
+/**
+ * @brief Calculates the inverse of the matrix @p m by 2x2 block decomposition.
+ * @details No test is made for singular matrices, which yield non-finite results.
+ * @return The inverse of the matrix @p m.
+ */
+static mat mat_inverse(const mat m) {
+
+	// the inverse of the transpose is the transpose of the inverse, so the
+	// columns are treated as rows of the blocks | A B |
+	//                                           | C D |
+
+	const vec A = _mm_movelh_ps(m.a, m.b);
+	const vec B = _mm_movehl_ps(m.b, m.a);
+	const vec C = _mm_movelh_ps(m.c, m.d);
+	const vec D = _mm_movehl_ps(m.d, m.c);
+
+	// (|A|, |B|, |C|, |D|)
+	const vec det = vec_subtract(
+		vec_multiply(_mm_shuffle_ps(m.a, m.c, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(m.b, m.d, _MM_SHUFFLE(3, 1, 3, 1))),
+		vec_multiply(_mm_shuffle_ps(m.a, m.c, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(m.b, m.d, _MM_SHUFFLE(2, 0, 2, 0)))
+	);
+
+	const vec det_A = _mm_shuffle_ps(det, det, 0x00);
+	const vec det_B = _mm_shuffle_ps(det, det, 0x55);
+	const vec det_C = _mm_shuffle_ps(det, det, 0xAA);
+	const vec det_D = _mm_shuffle_ps(det, det, 0xFF);
+
+	const vec D_C = mat2_adjugate_multiply(D, C);
+	const vec A_B = mat2_adjugate_multiply(A, B);
+
+	vec X = vec_subtract(vec_multiply(det_D, A), mat2_multiply(B, D_C));
+	vec W = vec_subtract(vec_multiply(det_A, D), mat2_multiply(C, A_B));
+	vec Y = vec_subtract(vec_multiply(det_B, C), mat2_multiply_adjugate(D, A_B));
+	vec Z = vec_subtract(vec_multiply(det_C, B), mat2_multiply_adjugate(A, D_C));
+
+	vec tr = vec_multiply(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+	tr = _mm_hadd_ps(tr, tr);
+	tr = _mm_hadd_ps(tr, tr);
+
+	const vec det_M = vec_subtract(vec_add(vec_multiply(det_A, det_D), vec_multiply(det_B, det_C)), tr);
+	const vec rcp = vec_divide(vec4f(1, -1, -1, 1), det_M);
+
+	X = vec_multiply(X, rcp);
+	Y = vec_multiply(Y, rcp);
+	Z = vec_multiply(Z, rcp);
+	W = vec_multiply(W, rcp);
+
+	return (mat) {
+		_mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)),
+		_mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)),
+		_mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)),
+		_mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2))
+	};
+}
+
+/**
+ * @brief Calculates the product of the matrices @p a `*` @p b.
+ * @return The product of the matrices @p a `*` @p b.
+ */
+static mat mat_multiply(const mat a, const mat b) {
+	return (mat) {
+		mat_transform(a, b.a),
+		mat_transform(a, b.b),
+		mat_transform(a, b.c),
+		mat_transform(a, b.d)
+	};
+}
+
+/**
+ * @brief Creates a rotation matrix of @p angle radians about @p axis.
+ * @param axis The axis of rotation, which need not be normalized.
+ * @param angle The angle of rotation, in radians.
+ * @return The rotation matrix.
+ */
+static mat mat_rotate(const vec axis, float angle) {
+
+	vec s, c;
+	vec_sincosf(vec_new(angle), &s, &c);
+
+	const vec n = vec_xyz(vec_normalize(axis));
+	const vec t = vec_multiply(n, vec_subtract(vec_new(1), c));
+	const vec u = vec_multiply(n, s);
+
+	// column i is t * n[i] + c * e[i] + u × e[i]
+	return (mat) {
+		vec_add(vec_multiply(t, _mm_shuffle_ps(n, n, 0x00)), _mm_blend_ps(vec_cross(u, vec1f(1)), c, 0x1)),
+		vec_add(vec_multiply(t, _mm_shuffle_ps(n, n, 0x55)), _mm_blend_ps(vec_cross(u, vec2f(0, 1)), c, 0x2)),
+		vec_add(vec_multiply(t, _mm_shuffle_ps(n, n, 0xAA)), _mm_blend_ps(vec_cross(u, vec3f(0, 0, 1)), c, 0x4)),
+		vec4f(0, 0, 0, 1)
+	};
+}
+
+/**
+ * @brief Creates a scale matrix.
+ * @param scale The `(x, y, z)` scale factors.
+ * @return The scale matrix.
+ */
+static mat mat_scale(const vec scale) {
+	return (mat) {
+		_mm_blend_ps(vec0(), scale, 0x1),
+		_mm_blend_ps(vec0(), scale, 0x2),
+		_mm_blend_ps(vec0(), scale, 0x4),
+		vec4f(0, 0, 0, 1)
+	};
+}
+
+/**
+ * @brief Transforms the four component vector @p v by the matrix @p m.
+ * @return The product of @p m `*` @p v.
+ */
+static vec mat_transform(const mat m, const vec v) {
+	return vec_add(
+		vec_add(vec_multiply(m.a, _mm_shuffle_ps(v, v, 0x00)), vec_multiply(m.b, _mm_shuffle_ps(v, v, 0x55))),
+		vec_add(vec_multiply(m.c, _mm_shuffle_ps(v, v, 0xAA)), vec_multiply(m.d, _mm_shuffle_ps(v, v, 0xFF)))
+	);
+}
+
+/**
+ * @brief Transforms the direction @p v by the matrix @p m, ignoring translation.
+ * @details The `w` component of @p v is ignored and treated as `0`.
+ * @return The product of @p m `*` `(v.x, v.y, v.z, 0)`.
+ */
+static vec mat_transform_direction(const mat m, const vec v) {
+	return vec_add(
+		vec_add(vec_multiply(m.a, _mm_shuffle_ps(v, v, 0x00)), vec_multiply(m.b, _mm_shuffle_ps(v, v, 0x55))),
+		vec_multiply(m.c, _mm_shuffle_ps(v, v, 0xAA))
+	);
+}
+
+/**
+ * @brief Transforms @p count directions by the matrix @p m, ignoring translation.
+ * @see mat_transform_points
+ */
+static void mat_transform_directions(const mat m, vec4 *out, const void *in, size_t stride, size_t count, int flags) {
+	mat_transform_points((mat) { m.a, m.b, m.c, vec0() }, out, in, stride, count, flags);
+}
+
+/**
+ * @brief Transforms the point @p v by the matrix @p m.
+ * @details The `w` component of @p v is ignored and treated as `1`.
+ * @return The product of @p m `*` `(v.x, v.y, v.z, 1)`.
+ */
+static vec mat_transform_point(const mat m, const vec v) {
+	return vec_add(
+		vec_add(vec_multiply(m.a, _mm_shuffle_ps(v, v, 0x00)), vec_multiply(m.b, _mm_shuffle_ps(v, v, 0x55))),
+		vec_add(vec_multiply(m.c, _mm_shuffle_ps(v, v, 0xAA)), m.d)
+	);
+}
+
+/**
+ * @brief Transforms @p count points by the matrix @p m.
+ * @param m The matrix.
+ * @param out The output array of four component vectors.
+ * @param in The input array, the first three floats of each element being the point.
+ * @param stride The size of each input element in bytes, at least `12`. Use `sizeof(vec3)` for
+ * packed points and `sizeof(vec4)` for four component vectors.
+ * @param count The number of points.
+ * @param flags A bitwise combination of mat_transform_flags.
+ */
+static void mat_transform_points(const mat m, vec4 *out, const void *in, size_t stride, size_t count, int flags) {
+
+	const char *src = in;
+	size_t i = 0;
+
+	#define MAT_TRANSFORM_POINTS_LOAD(j) \
+		mat_transform_point(m, _mm_loadu_ps((const float *) (src + (i + j) * stride)))
+
+	// full loads read up to 4 bytes past the element, so the last element is loaded separately
+
+	if ((flags & MAT_TRANSFORM_STREAM) && ((uintptr_t) out & 15) == 0) {
+		for (; i + 4 < count; i += 4) {
+			_mm_prefetch(src + (i + 16) * stride, _MM_HINT_T0);
+			_mm_stream_ps(out[i + 0].v, MAT_TRANSFORM_POINTS_LOAD(0));
+			_mm_stream_ps(out[i + 1].v, MAT_TRANSFORM_POINTS_LOAD(1));
+			_mm_stream_ps(out[i + 2].v, MAT_TRANSFORM_POINTS_LOAD(2));
+			_mm_stream_ps(out[i + 3].v, MAT_TRANSFORM_POINTS_LOAD(3));
+		}
+		_mm_sfence();
+	} else {
+		for (; i + 4 < count; i += 4) {
+			_mm_prefetch(src + (i + 16) * stride, _MM_HINT_T0);
+			_mm_storeu_ps(out[i + 0].v, MAT_TRANSFORM_POINTS_LOAD(0));
+			_mm_storeu_ps(out[i + 1].v, MAT_TRANSFORM_POINTS_LOAD(1));
+			_mm_storeu_ps(out[i + 2].v, MAT_TRANSFORM_POINTS_LOAD(2));
+			_mm_storeu_ps(out[i + 3].v, MAT_TRANSFORM_POINTS_LOAD(3));
+		}
+	}
+
+	#undef MAT_TRANSFORM_POINTS_LOAD
+
+	for (; i < count; i++) {
+		const float *f = (const float *) (src + i * stride);
+		_mm_storeu_ps(out[i].v, mat_transform_point(m, vec3f(f[0], f[1], f[2])));
+	}
+}
+
+/**
+ * @brief Creates a translation matrix.
+ * @param translation The `(x, y, z)` translation.
+ * @return The translation matrix.
+ */
+static mat mat_translate(const vec translation) {
+	return (mat) {
+		vec4f(1, 0, 0, 0),
+		vec4f(0, 1, 0, 0),
+		vec4f(0, 0, 1, 0),
+		_mm_blend_ps(translation, vec_new(1), 0x8)
+	};
+}
+
+/**
+ * @brief Calculates the transpose of the matrix @p m.
+ * @return The transpose of the matrix @p m.
+ */
+static mat mat_transpose(const mat m) {
+
+	const vec ab01 = _mm_unpacklo_ps(m.a, m.b);
+	const vec cd01 = _mm_unpacklo_ps(m.c, m.d);
+	const vec ab23 = _mm_unpackhi_ps(m.a, m.b);
+	const vec cd23 = _mm_unpackhi_ps(m.c, m.d);
+
+	return (mat) {
+		_mm_movelh_ps(ab01, cd01),
+		_mm_movehl_ps(cd01, ab01),
+		_mm_movelh_ps(ab23, cd23),
+		_mm_movehl_ps(cd23, ab23)
+	};
+}
+
+/**
+ * @brief Converts the rotation matrix @p m to a unit quaternion.
+ * @details The quaternion is calculated from its largest component, so that precision is
+ * retained for all rotations. The translation and projective row of @p m are ignored.
+ * @return The unit quaternion of the rotation matrix @p m.
+ */
+static quat quat_convert_mat(const mat m) {
+
+	const float r00 = vec_x(m.a), r10 = vec_y(m.a), r20 = vec_z(m.a);
+	const float r01 = vec_x(m.b), r11 = vec_y(m.b), r21 = vec_z(m.b);
+	const float r02 = vec_x(m.c), r12 = vec_y(m.c), r22 = vec_z(m.c);
+
+	float t;
+	quat q;
+
+	if (r22 < 0) {
+		if (r00 > r11) {
+			t = 1 + r00 - r11 - r22;
+			q = quat4f(t, r01 + r10, r02 + r20, r21 - r12);
+		} else {
+			t = 1 - r00 + r11 - r22;
+			q = quat4f(r01 + r10, t, r12 + r21, r02 - r20);
+		}
+	} else {
+		if (r00 < -r11) {
+			t = 1 - r00 - r11 + r22;
+			q = quat4f(r02 + r20, r12 + r21, t, r10 - r01);
+		} else {
+			t = 1 + r00 + r11 + r22;
+			q = quat4f(r21 - r12, r02 - r20, r10 - r01, t);
+		}
+	}
+
+	return vec_scale(q, .5f / sqrtf(t));
+}
+
+/**
+ * @brief Converts @p count rotation matrices to unit quaternions, four at a time.
+ * @param out The output array.
+ * @see quat_convert_mat
+ */
+static void quat_convert_mat_array(quat *out, const mat *m, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+
+		const mat a = mat_transpose((mat) { m[i].a, m[i + 1].a, m[i + 2].a, m[i + 3].a });
+		const mat b = mat_transpose((mat) { m[i].b, m[i + 1].b, m[i + 2].b, m[i + 3].b });
+		const mat c = mat_transpose((mat) { m[i].c, m[i + 1].c, m[i + 2].c, m[i + 3].c });
+
+		quatx4_store(quatx4_new_columns(
+			(vec3x4) { a.a, a.b, a.c },
+			(vec3x4) { b.a, b.b, b.c },
+			(vec3x4) { c.a, c.b, c.c }
+		), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_convert_mat(m[i]);
+	}
+}
+
+/**
+ * @}
+ */
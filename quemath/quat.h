@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "vec.h"
 
 /**
@@ -30,26 +32,352 @@
  */
 typedef vec quat;
 
+/**
+ * @brief Four quaternions in structure of arrays form.
+ * @details Each register holds one component of four quaternions, so that interpolation
+ * is evaluated for all four quaternions without horizontal operations.
+ */
+typedef struct {
+	/**
+	 * @brief Component accessors.
+	 */
+	vec x, y, z, w;
+} quatx4;
+
+/**
+ * @brief Dual quaternions, representing a rigid transform by a rotation and a translation.
+ * @details Blending dual quaternions, unlike blending matrices, preserves volume, so skinning
+ * with dual quaternions does not suffer the candy wrapper artifacts of linear blend skinning.
+ */
+typedef struct {
+	/**
+	 * @brief The rotation.
+	 */
+	quat real;
+
+	/**
+	 * @brief The translation, as `0.5 * t * real`.
+	 */
+	quat dual;
+} dquat;
+
+/**
+ * @brief Four dual quaternions in structure of arrays form.
+ */
+typedef struct {
+	/**
+	 * @brief Component accessors.
+	 */
+	quatx4 real, dual;
+} dquatx4;
+
+/**
+ * @brief Unit quaternions compressed to 32 bits by the smallest three method.
+ * @details The index of the largest component occupies the top 2 bits, followed by the three
+ * remaining components at 10 bits each, quantized to an odd number of levels so that zero is exact.
+ * The largest component is made positive and recalculated on decompression. Each of the three
+ * components errs by at most half of the quantization step `s = √2 / 1022`, and the recalculated
+ * component by at most `1.5 s`, near `(½, ½, ½, ½)`. The maximum component error is therefore
+ * `2.1e-3`, and the maximum rotation error `2√3 s` radians, or `0.275` degrees.
+ */
+typedef uint32_t quat32;
+
+/**
+ * @brief Unit quaternions compressed to 48 bits by the smallest three method.
+ * @details The three remaining components occupy the low 15 bits of each word, and the index of
+ * the largest component the top bit of the first two words. With the quantization step
+ * `s = √2 / 32766`, the maximum component error is `1.5 s`, or `6.5e-5`, and the maximum rotation
+ * error `2√3 s` radians, or `0.0086` degrees.
+ */
+typedef struct {
+	uint16_t v[3];
+} quat48;
+
+/**
+ * @brief Quaternions compressed to four 16 bit signed normalized components.
+ * @details The quaternion is normalized on decompression. With the quantization step
+ * `s = 1 / 32767`, the maximum component error is `0.75 s`, or `2.3e-5`, near `(½, ½, ½, ½)`, and
+ * the maximum rotation error `2 s` radians, or `0.0035` degrees.
+ */
+typedef struct {
+	int16_t v[4];
+} quat64;
+
+static inline dquat dquat_blend(const dquat *bones, const uint16_t *indices, const vec4 weights);
+static inline dquat dquat_identity(void);
+static inline dquat dquat_multiply(const dquat a, const dquat b);
+static inline dquat dquat_new(const quat rotation, const vec translation);
+static inline dquat dquat_normalize(const dquat dq);
+static inline void dquat_skin_array(vec3 *out, const vec3 *points, const uint16_t *indices, const vec4 *weights, const dquat *bones, size_t count);
+static inline vec dquat_transform_point(const dquat dq, const vec p);
+static inline vec dquat_translation(const dquat dq);
+
+static inline dquatx4 dquatx4_blend(const dquat *bones, const uint16_t *indices, const vec4 *weights);
+static inline vec3x4 dquatx4_transform_point(const dquatx4 dq, const vec3x4 p);
+
 static inline quat quat4f(float x, float y, float z, float w);
 static inline quat quat4fv(vec4 f);
 static inline quat quat_add(const quat a, const quat b);
 static inline ivec quat_compare_eq(const quat a, const quat b);
 static inline ivec quat_compare_ne(const quat a, const quat b);
+static inline quat quat_conjugate(const quat q);
+static inline quat quat_convert_quat32(const quat32 p);
+static inline void quat_convert_quat32_array(quat *out, const quat32 *in, size_t count);
+static inline quat quat_convert_quat48(const quat48 p);
+static inline void quat_convert_quat48_array(quat *out, const quat48 *in, size_t count);
+static inline quat quat_convert_quat64(const quat64 p);
+static inline void quat_convert_quat64_array(quat *out, const quat64 *in, size_t count);
 static inline int quat_equal(const quat a, const quat b);
 static inline quat quat_euler(const vec angles);
 static inline quat quat_identity(void);
 static inline quat quat_inverse(const quat q);
-static inline quat quat_look_at(const vec eye, const vec v);
+static inline quat quat_look_at(const vec eye, const vec target);
 static inline quat quat_multiply(const quat a, const quat b);
 static inline quat quat_new(const vec axis, float angle);
+static inline quat quat_nlerp(const quat a, const quat b, float t);
+static inline void quat_nlerp_array(quat *out, const quat *a, const quat *b, const float *t, size_t count);
 static inline quat quat_normalize(const quat q);
+static inline void quat_normalize_array(quat *out, const quat *in, size_t count);
+static inline quat quat_normalize_fast(const quat q);
+static inline void quat_normalize_fast_array(quat *out, const quat *in, size_t count);
 static inline int quat_not_equal(const quat a, const quat b);
+static inline vec quat_rotate(const quat q, const vec v);
+static inline quat quat_slerp(const quat a, const quat b, float t);
+static inline void quat_slerp_array(quat *out, const quat *a, const quat *b, const float *t, size_t count);
 static inline quat quat_subtract(const quat a, const quat b);
 static inline float quat_w(const quat q);
 static inline float quat_x(const quat q);
 static inline float quat_y(const quat q);
 static inline float quat_z(const quat q);
 
+static inline void quatx4_columns(const quatx4 q, vec3x4 *a, vec3x4 *b, vec3x4 *c);
+static inline quatx4 quatx4_convert_quat32(const ivec p);
+static inline quatx4 quatx4_convert_quat48(const ivec a, const ivec b, const ivec c);
+static inline vec quatx4_dot(const quatx4 a, const quatx4 b);
+static inline quatx4 quatx4_load(const quat *q);
+static inline quatx4 quatx4_new_columns(const vec3x4 a, const vec3x4 b, const vec3x4 c);
+static inline quatx4 quatx4_new_smallest_three(const ivec index, const vec3x4 v);
+static inline quatx4 quatx4_nlerp(const quatx4 a, const quatx4 b, const vec t);
+static inline quatx4 quatx4_normalize(const quatx4 q);
+static inline quatx4 quatx4_normalize_fast(const quatx4 q);
+static inline quatx4 quatx4_slerp(const quatx4 a, const quatx4 b, const vec t);
+static inline vec3x4 quatx4_smallest_three(const quatx4 q, ivec *index);
+static inline void quatx4_store(const quatx4 q, quat *out);
+
+static inline quat32 quat32_convert_quat(const quat q);
+static inline void quat32_convert_quat_array(quat32 *out, const quat *in, size_t count);
+static inline ivec quat32_convert_quatx4(const quatx4 q);
+static inline quat48 quat48_convert_quat(const quat q);
+static inline void quat48_convert_quat_array(quat48 *out, const quat *in, size_t count);
+static inline void quat48_convert_quatx4(const quatx4 q, ivec *a, ivec *b, ivec *c);
+static inline quat64 quat64_convert_quat(const quat q);
+static inline void quat64_convert_quat_array(quat64 *out, const quat *in, size_t count);
+
+/**
+ * @brief Blends up to four dual quaternions by weight, for dual quaternion skinning.
+ * @details Each bone is negated if necessary to lie in the same hemisphere as the first,
+ * so that the blend takes the shortest path.
+ * @param bones The bone transforms.
+ * @param indices The four bone indices.
+ * @param weights The four bone weights. Unused bones should have zero weight.
+ * @return The normalized blend of the weighted bones.
+ */
+static dquat dquat_blend(const dquat *bones, const uint16_t *indices, const vec4 weights) {
+
+	const dquat first = bones[indices[0]];
+
+	dquat blend = { vec0(), vec0() };
+	for (int i = 0; i < 4; i++) {
+		const dquat bone = bones[indices[i]];
+
+		const vec sign = _mm_and_ps(vec_dot4_broadcast(first.real, bone.real), vec_new(-0.f));
+		const vec weight = _mm_xor_ps(vec_new(weights.v[i]), sign);
+
+		blend.real = vec_add(blend.real, vec_multiply(bone.real, weight));
+		blend.dual = vec_add(blend.dual, vec_multiply(bone.dual, weight));
+	}
+
+	return dquat_normalize(blend);
+}
+
+/**
+ * @return The identity dual quaternion.
+ */
+static dquat dquat_identity(void) {
+	return (dquat) { quat_identity(), vec0() };
+}
+
+/**
+ * @brief Calculates the product of the dual quaternions @p a and @p b.
+ * @return The dual quaternion applying @p b, and then @p a.
+ */
+static dquat dquat_multiply(const dquat a, const dquat b) {
+	return (dquat) {
+		quat_multiply(a.real, b.real),
+		vec_add(quat_multiply(a.real, b.dual), quat_multiply(a.dual, b.real))
+	};
+}
+
+/**
+ * @brief Creates the dual quaternion applying @p rotation, and then @p translation.
+ * @param rotation The unit rotation quaternion.
+ * @param translation The translation, whose `w` component is ignored.
+ */
+static dquat dquat_new(const quat rotation, const vec translation) {
+	return (dquat) {
+		rotation,
+		vec_scale(quat_multiply(vec_xyz(translation), rotation), 0.5)
+	};
+}
+
+/**
+ * @brief Normalizes the dual quaternion @p dq.
+ * @details The real part is scaled to unit length, and the dual part is made orthogonal to it.
+ * @return The unit dual quaternion of @p dq.
+ */
+static dquat dquat_normalize(const dquat dq) {
+
+	const vec length = vec_sqrt(vec_dot4_broadcast(dq.real, dq.real));
+
+	const quat real = vec_divide(dq.real, length);
+	const quat dual = vec_divide(dq.dual, length);
+
+	return (dquat) {
+		real,
+		vec_subtract(dual, vec_multiply(real, vec_dot4_broadcast(real, dual)))
+	};
+}
+
+/**
+ * @brief Dual quaternion skinning of @p count points by up to four bones each.
+ * @param out The skinned points, which may alias @p points.
+ * @param points The bind pose points.
+ * @param indices The bone indices, four per point.
+ * @param weights The bone weights, one vector per point. Unused bones should have zero weight.
+ * @param bones The bone transforms, from bind pose to pose.
+ * @param count The number of points.
+ */
+static void dquat_skin_array(vec3 *out, const vec3 *points, const uint16_t *indices, const vec4 *weights, const dquat *bones, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const dquatx4 blend = dquatx4_blend(bones, indices + i * 4, weights + i);
+		vec3x4_store(dquatx4_transform_point(blend, vec3x4_load(points + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		const dquat blend = dquat_blend(bones, indices + i * 4, weights[i]);
+		out[i] = vec_vec3(dquat_transform_point(blend, vec3fv(points[i])));
+	}
+}
+
+/**
+ * @brief Transforms the point @p p by the unit dual quaternion @p dq.
+ * @return The rotated and translated point.
+ */
+static vec dquat_transform_point(const dquat dq, const vec p) {
+	return vec_add(quat_rotate(dq.real, p), dquat_translation(dq));
+}
+
+/**
+ * @return The translation of the unit dual quaternion @p dq, `2 * dual * conjugate(real)`.
+ */
+static vec dquat_translation(const dquat dq) {
+	return vec_xyz(vec_scale(quat_multiply(dq.dual, quat_conjugate(dq.real)), 2));
+}
+
+/**
+ * @brief Blends up to four dual quaternions by weight for each of four points.
+ * @details Unlike dquat_blend, the dual part is only scaled, and not made orthogonal to the real
+ * part, as dquatx4_transform_point does not require it.
+ * @param bones The bone transforms.
+ * @param indices The bone indices, four per point.
+ * @param weights The bone weights, one vector per point.
+ * @return The four blends of the weighted bones, with unit length real parts.
+ */
+static dquatx4 dquatx4_blend(const dquat *bones, const uint16_t *indices, const vec4 *weights) {
+
+	vec w[4] = {
+		_mm_loadu_ps(weights[0].v),
+		_mm_loadu_ps(weights[1].v),
+		_mm_loadu_ps(weights[2].v),
+		_mm_loadu_ps(weights[3].v)
+	};
+	_MM_TRANSPOSE4_PS(w[0], w[1], w[2], w[3]);
+
+	const quatx4 zero = { vec0(), vec0(), vec0(), vec0() };
+
+	dquatx4 blend = { zero, zero };
+	quatx4 first = zero;
+
+	for (int i = 0; i < 4; i++) {
+
+		const dquat *b0 = &bones[indices[i + 0]];
+		const dquat *b1 = &bones[indices[i + 4]];
+		const dquat *b2 = &bones[indices[i + 8]];
+		const dquat *b3 = &bones[indices[i + 12]];
+
+		const quat real[4] = { b0->real, b1->real, b2->real, b3->real };
+		const quat dual[4] = { b0->dual, b1->dual, b2->dual, b3->dual };
+
+		const dquatx4 bone = { quatx4_load(real), quatx4_load(dual) };
+		if (i == 0) {
+			first = bone.real;
+		}
+
+		const vec weight = _mm_xor_ps(w[i], _mm_and_ps(quatx4_dot(first, bone.real), vec_new(-0.f)));
+
+		blend.real.x = vec_add(blend.real.x, vec_multiply(bone.real.x, weight));
+		blend.real.y = vec_add(blend.real.y, vec_multiply(bone.real.y, weight));
+		blend.real.z = vec_add(blend.real.z, vec_multiply(bone.real.z, weight));
+		blend.real.w = vec_add(blend.real.w, vec_multiply(bone.real.w, weight));
+		blend.dual.x = vec_add(blend.dual.x, vec_multiply(bone.dual.x, weight));
+		blend.dual.y = vec_add(blend.dual.y, vec_multiply(bone.dual.y, weight));
+		blend.dual.z = vec_add(blend.dual.z, vec_multiply(bone.dual.z, weight));
+		blend.dual.w = vec_add(blend.dual.w, vec_multiply(bone.dual.w, weight));
+	}
+
+	const vec length = vec_sqrt(quatx4_dot(blend.real, blend.real));
+
+	blend.real.x = vec_divide(blend.real.x, length);
+	blend.real.y = vec_divide(blend.real.y, length);
+	blend.real.z = vec_divide(blend.real.z, length);
+	blend.real.w = vec_divide(blend.real.w, length);
+	blend.dual.x = vec_divide(blend.dual.x, length);
+	blend.dual.y = vec_divide(blend.dual.y, length);
+	blend.dual.z = vec_divide(blend.dual.z, length);
+	blend.dual.w = vec_divide(blend.dual.w, length);
+
+	return blend;
+}
+
+/**
+ * @brief Transforms the four points @p p by the four dual quaternions @p dq.
+ * @details `p' = p + 2 r x (r x p + w p) + 2 (w r' - w' r + r x r')`, where `(r, w)` is the
+ * real part and `(r', w')` the dual part of @p dq. The real part must be of unit length.
+ * @return The four rotated and translated points.
+ */
+static vec3x4 dquatx4_transform_point(const dquatx4 dq, const vec3x4 p) {
+
+	const vec3x4 r = { dq.real.x, dq.real.y, dq.real.z };
+	const vec3x4 d = { dq.dual.x, dq.dual.y, dq.dual.z };
+	const vec w = dq.real.w, dw = dq.dual.w;
+
+	const vec3x4 a = vec3x4_cross(r, p);
+	const vec3x4 b = vec3x4_cross(r, (vec3x4) {
+		vec_add(a.x, vec_multiply(w, p.x)),
+		vec_add(a.y, vec_multiply(w, p.y)),
+		vec_add(a.z, vec_multiply(w, p.z))
+	});
+	const vec3x4 c = vec3x4_cross(r, d);
+
+	const vec3x4 t = {
+		vec_add(vec_subtract(vec_multiply(w, d.x), vec_multiply(dw, r.x)), c.x),
+		vec_add(vec_subtract(vec_multiply(w, d.y), vec_multiply(dw, r.y)), c.y),
+		vec_add(vec_subtract(vec_multiply(w, d.z), vec_multiply(dw, r.z)), c.z)
+	};
+
+	return vec3x4_add(p, vec3x4_scale(vec3x4_add(b, t), 2));
+}
+
 static quat quat4f(float x, float y, float z, float w) {
 	return vec4f(x, y, z, w);
 }
@@ -70,20 +398,123 @@ static ivec quat_compare_ne(const quat a, const quat b) {
 	return vec_compare_ne(a, b);
 }
 
+/**
+ * @brief Calculates the conjugate of the quaternion @p q.
+ * @return The quaternion `(-x, -y, -z, w)`.
+ */
+static quat quat_conjugate(const quat q) {
+	return _mm_xor_ps(q, vec4f(-0.f, -0.f, -0.f, 0.f));
+}
+
+/**
+ * @brief Decompresses the smallest three quaternion @p p.
+ * @return The unit quaternion.
+ */
+static quat quat_convert_quat32(const quat32 p) {
+	quat q[4];
+	quatx4_store(quatx4_convert_quat32(_mm_set1_epi32((int) p)), q);
+	return q[0];
+}
+
+/**
+ * @brief Decompresses @p count smallest three quaternions, four at a time.
+ * @param in The compressed quaternions, which need not be aligned.
+ */
+static void quat_convert_quat32_array(quat *out, const quat32 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		quatx4_store(quatx4_convert_quat32(_mm_loadu_si128((const __m128i *) (in + i))), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_convert_quat32(in[i]);
+	}
+}
+
+/**
+ * @brief Decompresses the smallest three quaternion @p p.
+ * @return The unit quaternion.
+ */
+static quat quat_convert_quat48(const quat48 p) {
+	quat q[4];
+	quatx4_store(quatx4_convert_quat48(ivec_new(p.v[0]), ivec_new(p.v[1]), ivec_new(p.v[2])), q);
+	return q[0];
+}
+
+/**
+ * @brief Decompresses @p count smallest three quaternions, four at a time.
+ * @param in The compressed quaternions.
+ */
+static void quat_convert_quat48_array(quat *out, const quat48 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+
+		// words a0 b0 c0 a1 b1 c1 a2 b2 and c2 a3 b3 c3, gathered and zero extended to components
+		const ivec lo = _mm_loadu_si128((const __m128i *) (in + i));
+		const ivec hi = _mm_loadl_epi64((const __m128i *) ((const uint16_t *) (in + i) + 8));
+
+		const ivec a = _mm_or_si128(
+			_mm_shuffle_epi8(lo, _mm_setr_epi8(0, 1, -1, -1, 6, 7, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1)),
+			_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1)));
+		const ivec b = _mm_or_si128(
+			_mm_shuffle_epi8(lo, _mm_setr_epi8(2, 3, -1, -1, 8, 9, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1)),
+			_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, -1, -1)));
+		const ivec c = _mm_or_si128(
+			_mm_shuffle_epi8(lo, _mm_setr_epi8(4, 5, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+			_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1)));
+
+		quatx4_store(quatx4_convert_quat48(a, b, c), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_convert_quat48(in[i]);
+	}
+}
+
+/**
+ * @brief Decompresses the signed normalized quaternion @p p.
+ * @return The unit quaternion.
+ */
+static quat quat_convert_quat64(const quat64 p) {
+	const ivec i = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) p.v));
+	return quat_normalize(vec_convert_ivec(i));
+}
+
+/**
+ * @brief Decompresses @p count signed normalized quaternions, four at a time.
+ * @param in The compressed quaternions, which need not be aligned.
+ */
+static void quat_convert_quat64_array(quat *out, const quat64 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec a = _mm_loadu_si128((const __m128i *) (in + i));
+		const ivec b = _mm_loadu_si128((const __m128i *) (in + i + 2));
+
+		out[i + 0] = quat_normalize(vec_convert_ivec(_mm_cvtepi16_epi32(a)));
+		out[i + 1] = quat_normalize(vec_convert_ivec(_mm_cvtepi16_epi32(_mm_srli_si128(a, 8))));
+		out[i + 2] = quat_normalize(vec_convert_ivec(_mm_cvtepi16_epi32(b)));
+		out[i + 3] = quat_normalize(vec_convert_ivec(_mm_cvtepi16_epi32(_mm_srli_si128(b, 8))));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_convert_quat64(in[i]);
+	}
+}
+
 static int quat_equal(const quat a, const quat b) {
 	return vec_equal(a, b);
 }
 
 static quat quat_euler(const vec angles) {
 
-	const vec3 c = vec_vec3(vec_cosf(vec_scale(angles, 0.5)));
-	const vec3 s = vec_vec3(vec_sinf(vec_scale(angles, 0.5)));
+	vec cv, sv;
+	vec_sincosf(vec_scale(angles, 0.5), &sv, &cv);
+
+	const vec3 c = vec_vec3(cv);
+	const vec3 s = vec_vec3(sv);
 
 	return quat4f(
-		c.x * c.y * c.z + s.x * s.y * s.z,
 		s.x * c.y * c.z - c.x * s.y * s.z,
 		c.x * s.y * c.z + s.x * c.y * s.z,
-		c.x * c.y * s.z - s.x * s.y * c.z
+		c.x * c.y * s.z - s.x * s.y * c.z,
+		c.x * c.y * c.z + s.x * s.y * s.z
 	);
 }
 
@@ -91,23 +522,146 @@ static quat quat_identity(void) {
 	return quat4f(0, 0, 0, 1);
 }
 
+/**
+ * @brief Calculates the inverse of the quaternion @p q.
+ * @details For unit quaternions, quat_conjugate is equivalent and cheaper.
+ * @return The inverse of the quaternion @p q.
+ */
+static quat quat_inverse(const quat q) {
+	return vec_divide(quat_conjugate(q), vec_dot4_broadcast(q, q));
+}
+
+/**
+ * @brief Creates the rotation that orients the forward axis `+X` from @p eye toward @p target.
+ * @details The rotation is composed of pitch and yaw only, with `+Z` up, as Quake's `VectorAngles`.
+ * @return The rotation quaternion, or the identity if @p eye and @p target are equal.
+ */
+static quat quat_look_at(const vec eye, const vec target) {
+
+	const vec d = vec_xyz(vec_subtract(target, eye));
+
+	// pitch is atan2(-z, sqrt(x * x + y * y)), yaw is atan2(y, x), and roll is atan2(0, 1)
+	const vec y = _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 1, 2, 3)), vec2f(0, -0.f));
+	vec x = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 0, 0, 0));
+	x = _mm_insert_ps(x, vec_sqrt(vec_dot2(d, d)), 0x10);
+	x = _mm_blend_ps(x, vec_new(1), 0x1);
+
+	return quat_euler(vec_atan2f(y, x));
+}
+
+/**
+ * @brief Calculates the product of the quaternions @p a `*` @p b.
+ * @details The product represents the rotation @p b followed by the rotation @p a.
+ * @return The product of the quaternions @p a `*` @p b.
+ */
+static quat quat_multiply(const quat a, const quat b) {
+
+	const vec x = vec_multiply(_mm_shuffle_ps(a, a, 0x00), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)));
+	const vec y = vec_multiply(_mm_shuffle_ps(a, a, 0x55), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)));
+	const vec z = vec_multiply(_mm_shuffle_ps(a, a, 0xAA), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)));
+	const vec w = vec_multiply(_mm_shuffle_ps(a, a, 0xFF), b);
+
+	return vec_add(
+		vec_add(w, _mm_xor_ps(x, vec4f(0.f, -0.f, 0.f, -0.f))),
+		vec_add(_mm_xor_ps(y, vec4f(0.f, 0.f, -0.f, -0.f)), _mm_xor_ps(z, vec4f(-0.f, 0.f, 0.f, -0.f)))
+	);
+}
+
+/**
+ * @brief Creates the rotation of @p angle radians about @p axis.
+ * @param axis The axis of rotation, which need not be normalized.
+ * @param angle The angle of rotation, in radians.
+ * @return The rotation quaternion, or the identity if @p axis is zero.
+ */
 static quat quat_new(const vec axis, float angle) {
 
-	const float s = sinf(angle * 0.5);
-	const float c = cosf(angle * 0.5);
+	vec s, c;
+	vec_sincosf(vec_new(angle * 0.5), &s, &c);
+
+	// scaling w by the length of axis normalizes the axis along with the quaternion
+	const vec length = vec_sqrt(vec_dot3_broadcast(axis, axis));
 
-	return quat_normalize(vec_add(vec_scale(axis, s), vec4f(0, 0, 0, c)));
+	return quat_normalize(_mm_blend_ps(vec_multiply(axis, s), vec_multiply(c, length), 0x8));
 }
 
+/**
+ * @brief Normalized linear interpolation of the quaternions @p a and @p b along the shortest path.
+ * @details The angular velocity is not constant, but the result lies on the same arc as quat_slerp.
+ * @param t The interpolation fraction, `0` yielding @p a and `1` yielding @p b.
+ * @return The unit quaternion between @p a and @p b.
+ */
+static quat quat_nlerp(const quat a, const quat b, float t) {
+
+	// negate b if necessary so that the interpolation takes the shortest path
+	const vec sign = _mm_and_ps(vec_dot4_broadcast(a, b), vec_new(-0.f));
+
+	return quat_normalize(vec_mix(a, _mm_xor_ps(b, sign), t));
+}
+
+/**
+ * @brief Normalized linear interpolation of @p count quaternion pairs by per-element fractions @p t.
+ * @param out The output array, which may alias @p a or @p b.
+ * @see quat_nlerp
+ */
+static void quat_nlerp_array(quat *out, const quat *a, const quat *b, const float *t, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		quatx4_store(quatx4_nlerp(quatx4_load(a + i), quatx4_load(b + i), _mm_loadu_ps(t + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_nlerp(a[i], b[i], t[i]);
+	}
+}
+
+/**
+ * @brief Calculates the unit length quaternion of @p q by the square root.
+ * @return The unit quaternion of @p q, or the identity if the `xyz` components of @p q are zero.
+ */
 static quat quat_normalize(const quat q) {
+	const vec zero = _mm_cmpeq_ps(vec_dot3_broadcast(q, q), vec0());
+	return _mm_blendv_ps(vec_divide(q, vec_sqrt(vec_dot4_broadcast(q, q))), quat_identity(), zero);
+}
+
+/**
+ * @brief Normalizes @p count quaternions by the square root.
+ * @param out The output array, which may alias @p in.
+ * @see quatx4_normalize
+ */
+static void quat_normalize_array(quat *out, const quat *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		quatx4_store(quatx4_normalize(quatx4_load(in + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_normalize(in[i]);
+	}
+}
+
+/**
+ * @brief Calculates the approximate unit length quaternion of @p q by the inverse square root.
+ * @details The inverse square root estimate is refined with one Newton-Raphson step, for a
+ * relative error of about `1e-7`.
+ * @return The unit quaternion of @p q, or the identity if the `xyz` components of @p q are zero.
+ */
+static quat quat_normalize_fast(const quat q) {
+	const vec dot = vec_dot4_broadcast(q, q);
+	const vec zero = _mm_cmpeq_ps(vec_dot3_broadcast(q, q), vec0());
+
+	return _mm_blendv_ps(vec_multiply(q, vec_rsqrt_refined(dot)), quat_identity(), zero);
+}
 
-	printf("%g %g %g %g\n", q[0], q[1], q[2], q[3]);
-	if (vec_equal(vec_xyz(q), vec0())) {
-		return quat_identity();
-	} else {
-		const vec dot = _mm_dp_ps(q, q, 0xFF);
-		printf("dafuq %g\n", dot[0]);
-		return vec_divide(q, vec_sqrt(_mm_dp_ps(q, q, 0xFF)));
+/**
+ * @brief Approximately normalizes @p count quaternions by the inverse square root.
+ * @param out The output array, which may alias @p in.
+ * @see quatx4_normalize_fast
+ */
+static void quat_normalize_fast_array(quat *out, const quat *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		quatx4_store(quatx4_normalize_fast(quatx4_load(in + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat_normalize_fast(in[i]);
 	}
 }
 
@@ -115,6 +669,80 @@ static int quat_not_equal(const quat a, const quat b) {
 	return vec_not_equal(a, b);
 }
 
+/**
+ * @brief Rotates the vector @p v by the unit quaternion @p q, without building a matrix.
+ * @details The `w` component of @p v is preserved.
+ * @return The rotated vector.
+ */
+static vec quat_rotate(const quat q, const vec v) {
+
+	// v + w * t + q.xyz × t, where t = 2 * (q.xyz × v)
+	const vec t = vec_scale(vec_cross(q, v), 2);
+
+	return vec_add(vec_add(v, vec_multiply(_mm_shuffle_ps(q, q, 0xFF), t)), vec_cross(q, t));
+}
+
+/**
+ * @brief Spherical linear interpolation of the quaternions @p a and @p b along the shortest path.
+ * @details Nearly parallel quaternions, whose sine is too small to divide by, fall back to quat_nlerp.
+ * @param t The interpolation fraction, `0` yielding @p a and `1` yielding @p b.
+ * @return The unit quaternion between @p a and @p b, at constant angular velocity in @p t.
+ */
+static quat quat_slerp(const quat a, const quat b, float t) {
+
+	const vec dot = vec_dot4_broadcast(a, b);
+	const vec sign = _mm_and_ps(dot, vec_new(-0.f));
+
+	const vec cos_theta = vec_min(_mm_xor_ps(dot, sign), vec_new(1.f));
+	const vec theta = vec_acosf(cos_theta);
+
+	// (sin((1 - t) theta), sin(t theta), sin(theta), sin(theta))
+	const vec s = vec_sinf(vec_multiply(theta, vec4f(1.f - t, t, 1.f, 1.f)));
+	const vec weights = vec_divide(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 2, 2)));
+
+	const vec slerp = vec_add(
+		vec_multiply(a, _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(0, 0, 0, 0))),
+		vec_multiply(_mm_xor_ps(b, sign), _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 1, 1, 1)))
+	);
+
+	const vec parallel = _mm_cmpgt_ps(cos_theta, vec_new(0.9995f));
+
+	return _mm_blendv_ps(slerp, quat_nlerp(a, b, t), parallel);
+}
+
+/**
+ * @brief Approximate spherical linear interpolation of @p count quaternion pairs by per-element fractions @p t.
+ * @param out The output array, which may alias @p a or @p b.
+ * @see quatx4_slerp
+ */
+static void quat_slerp_array(quat *out, const quat *a, const quat *b, const float *t, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		quatx4_store(quatx4_slerp(quatx4_load(a + i), quatx4_load(b + i), _mm_loadu_ps(t + i)), out + i);
+	}
+	if (batch < count) {
+
+		// pad the remainder so that every element is interpolated by the same approximation
+		quat pa[4], pb[4], po[4];
+		float pt[4] = { 0.f };
+
+		for (size_t i = 0; i < 4; i++) {
+			pa[i] = pb[i] = quat_identity();
+		}
+		for (size_t i = batch; i < count; i++) {
+			pa[i - batch] = a[i];
+			pb[i - batch] = b[i];
+			pt[i - batch] = t[i];
+		}
+
+		quatx4_store(quatx4_slerp(quatx4_load(pa), quatx4_load(pb), _mm_loadu_ps(pt)), po);
+
+		for (size_t i = batch; i < count; i++) {
+			out[i] = po[i - batch];
+		}
+	}
+}
+
 static quat quat_subtract(const quat a, const quat b) {
 	return vec_subtract(a, b);
 }
@@ -147,3 +775,485 @@ static float quat_z(const quat q) {
 	return vec_z(q);
 }
 
+/**
+ * @brief Calculates the columns of the rotation matrices of the four unit quaternions @p q.
+ * @param a The first columns of the four rotation matrices.
+ * @param b The second columns of the four rotation matrices.
+ * @param c The third columns of the four rotation matrices.
+ */
+static void quatx4_columns(const quatx4 q, vec3x4 *a, vec3x4 *b, vec3x4 *c) {
+
+	const vec x2 = vec_add(q.x, q.x);
+	const vec y2 = vec_add(q.y, q.y);
+	const vec z2 = vec_add(q.z, q.z);
+
+	const vec xx = vec_multiply(q.x, x2), yy = vec_multiply(q.y, y2), zz = vec_multiply(q.z, z2);
+	const vec xy = vec_multiply(q.x, y2), xz = vec_multiply(q.x, z2), yz = vec_multiply(q.y, z2);
+	const vec wx = vec_multiply(q.w, x2), wy = vec_multiply(q.w, y2), wz = vec_multiply(q.w, z2);
+
+	const vec one = vec_new(1.f);
+
+	*a = (vec3x4) { vec_subtract(vec_subtract(one, yy), zz), vec_add(xy, wz), vec_subtract(xz, wy) };
+	*b = (vec3x4) { vec_subtract(xy, wz), vec_subtract(vec_subtract(one, xx), zz), vec_add(yz, wx) };
+	*c = (vec3x4) { vec_add(xz, wy), vec_subtract(yz, wx), vec_subtract(vec_subtract(one, xx), yy) };
+}
+
+/**
+ * @brief Decompresses four smallest three quaternions.
+ * @param p The four quaternions, as quat32.
+ */
+static quatx4 quatx4_convert_quat32(const ivec p) {
+
+	const vec scale = vec_new(2.f / (1022 * M_SQRT2));
+	const vec bias = vec_new(-M_SQRT1_2);
+
+	const ivec mask = ivec_new(1023);
+
+	return quatx4_new_smallest_three(_mm_srli_epi32(p, 30), (vec3x4) {
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(_mm_srli_epi32(p, 20), mask)), scale), bias),
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(_mm_srli_epi32(p, 10), mask)), scale), bias),
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(p, mask)), scale), bias)
+	});
+}
+
+/**
+ * @brief Decompresses four smallest three quaternions.
+ * @param a The first words of the four quaternions, zero extended.
+ * @param b The second words of the four quaternions, zero extended.
+ * @param c The third words of the four quaternions, zero extended.
+ */
+static quatx4 quatx4_convert_quat48(const ivec a, const ivec b, const ivec c) {
+
+	const vec scale = vec_new(2.f / (32766 * M_SQRT2));
+	const vec bias = vec_new(-M_SQRT1_2);
+
+	const ivec mask = ivec_new(32767);
+	return quatx4_new_smallest_three(_mm_or_si128(_mm_srli_epi32(a, 15), _mm_slli_epi32(_mm_srli_epi32(b, 15), 1)), (vec3x4) {
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(a, mask)), scale), bias),
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(b, mask)), scale), bias),
+		vec_add(vec_multiply(vec_convert_ivec(_mm_and_si128(c, mask)), scale), bias)
+	});
+}
+
+/**
+ * @return The four dot products of the quaternions @p a and @p b.
+ */
+static vec quatx4_dot(const quatx4 a, const quatx4 b) {
+	return vec_add(
+		vec_add(vec_multiply(a.x, b.x), vec_multiply(a.y, b.y)),
+		vec_add(vec_multiply(a.z, b.z), vec_multiply(a.w, b.w))
+	);
+}
+
+/**
+ * @brief Loads four consecutive quaternions into structure of arrays form.
+ */
+static quatx4 quatx4_load(const quat *q) {
+
+	vec x = q[0], y = q[1], z = q[2], w = q[3];
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	return (quatx4) { x, y, z, w };
+}
+
+/**
+ * @brief Creates the four unit quaternions of the rotation matrices with columns @p a, @p b and @p c.
+ * @details Each quaternion is calculated from its largest component, selected without branching,
+ * so that precision is retained for all rotations.
+ * @param a The first columns of the four rotation matrices.
+ * @param b The second columns of the four rotation matrices.
+ * @param c The third columns of the four rotation matrices.
+ */
+static quatx4 quatx4_new_columns(const vec3x4 a, const vec3x4 b, const vec3x4 c) {
+
+	const vec one = vec_new(1.f);
+
+	const vec tx = vec_subtract(vec_subtract(vec_add(one, a.x), b.y), c.z);
+	const vec ty = vec_subtract(vec_add(vec_subtract(one, a.x), b.y), c.z);
+	const vec tz = vec_add(vec_subtract(vec_subtract(one, a.x), b.y), c.z);
+	const vec tw = vec_add(vec_add(vec_add(one, a.x), b.y), c.z);
+
+	// the largest of x, y, z and w, as a mask for each
+	const vec negative = _mm_cmplt_ps(c.z, vec0());
+	const vec mx = _mm_and_ps(negative, _mm_cmpgt_ps(a.x, b.y));
+	const vec my = _mm_andnot_ps(mx, negative);
+	const vec mz = _mm_andnot_ps(negative, _mm_cmplt_ps(a.x, vec_negate(b.y)));
+
+	const vec t = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(tw, tz, mz), ty, my), tx, mx);
+
+	const vec xy = vec_add(b.x, a.y);
+	const vec xz = vec_add(c.x, a.z);
+	const vec yz = vec_add(c.y, b.z);
+	const vec wx = vec_subtract(b.z, c.y);
+	const vec wy = vec_subtract(c.x, a.z);
+	const vec wz = vec_subtract(a.y, b.x);
+
+	const quatx4 q = {
+		_mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wx, xz, mz), xy, my), t, mx),
+		_mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wy, yz, mz), t, my), xy, mx),
+		_mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wz, t, mz), yz, my), xz, mx),
+		_mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(t, wz, mz), wy, my), wx, mx)
+	};
+
+	const vec scale = vec_divide(vec_new(.5f), vec_sqrt(t));
+
+	return (quatx4) {
+		vec_multiply(q.x, scale),
+		vec_multiply(q.y, scale),
+		vec_multiply(q.z, scale),
+		vec_multiply(q.w, scale)
+	};
+}
+
+/**
+ * @brief Creates four unit quaternions from their three smallest components.
+ * @param index The indices of the largest, positive, components.
+ * @param v The remaining components, in order.
+ */
+static quatx4 quatx4_new_smallest_three(const ivec index, const vec3x4 v) {
+
+	const vec largest = vec_sqrt(vec_max(vec0(), vec_subtract(vec_new(1.f), vec3x4_dot3(v, v))));
+
+	const vec i0 = vec_cast_ivec(ivec_compare_eq(index, ivec_new(0)));
+	const vec i1 = vec_cast_ivec(ivec_compare_eq(index, ivec_new(1)));
+	const vec i2 = vec_cast_ivec(ivec_compare_eq(index, ivec_new(2)));
+	const vec i3 = vec_cast_ivec(ivec_compare_eq(index, ivec_new(3)));
+
+	return (quatx4) {
+		_mm_blendv_ps(v.x, largest, i0),
+		_mm_blendv_ps(_mm_blendv_ps(v.y, largest, i1), v.x, i0),
+		_mm_blendv_ps(_mm_blendv_ps(v.z, largest, i2), v.y, _mm_or_ps(i0, i1)),
+		_mm_blendv_ps(v.z, largest, i3)
+	};
+}
+
+/**
+ * @brief Normalized linear interpolation of four quaternion pairs along the shortest path.
+ * @param t The four interpolation fractions.
+ * @see quat_nlerp
+ */
+static quatx4 quatx4_nlerp(const quatx4 a, const quatx4 b, const vec t) {
+
+	const vec sign = _mm_and_ps(quatx4_dot(a, b), vec_new(-0.f));
+	const vec u = vec_subtract(vec_new(1.f), t);
+	const vec v = _mm_xor_ps(t, sign);
+
+	return quatx4_normalize((quatx4) {
+		vec_add(vec_multiply(a.x, u), vec_multiply(b.x, v)),
+		vec_add(vec_multiply(a.y, u), vec_multiply(b.y, v)),
+		vec_add(vec_multiply(a.z, u), vec_multiply(b.z, v)),
+		vec_add(vec_multiply(a.w, u), vec_multiply(b.w, v))
+	});
+}
+
+/**
+ * @brief Calculates the unit length quaternions of @p q by the square root.
+ * @return Four unit quaternions of @p q, with the identity where the `xyz` components of @p q are
+ * zero, as by quat_normalize.
+ */
+static quatx4 quatx4_normalize(const quatx4 q) {
+
+	const vec length = vec_sqrt(quatx4_dot(q, q));
+
+	const vec xyz = vec_add(vec_add(vec_multiply(q.x, q.x), vec_multiply(q.y, q.y)), vec_multiply(q.z, q.z));
+	const vec zero = _mm_cmpeq_ps(xyz, vec0());
+
+	return (quatx4) {
+		_mm_andnot_ps(zero, vec_divide(q.x, length)),
+		_mm_andnot_ps(zero, vec_divide(q.y, length)),
+		_mm_andnot_ps(zero, vec_divide(q.z, length)),
+		_mm_blendv_ps(vec_divide(q.w, length), vec_new(1.f), zero)
+	};
+}
+
+/**
+ * @brief Calculates the approximate unit length quaternions of @p q by the inverse square root.
+ * @return Four unit quaternions of @p q, with the identity where the `xyz` components of @p q are
+ * zero, as by quat_normalize_fast.
+ */
+static quatx4 quatx4_normalize_fast(const quatx4 q) {
+
+	const vec scale = vec_rsqrt_refined(quatx4_dot(q, q));
+
+	const vec xyz = vec_add(vec_add(vec_multiply(q.x, q.x), vec_multiply(q.y, q.y)), vec_multiply(q.z, q.z));
+	const vec zero = _mm_cmpeq_ps(xyz, vec0());
+
+	return (quatx4) {
+		_mm_andnot_ps(zero, vec_multiply(q.x, scale)),
+		_mm_andnot_ps(zero, vec_multiply(q.y, scale)),
+		_mm_andnot_ps(zero, vec_multiply(q.z, scale)),
+		_mm_blendv_ps(vec_multiply(q.w, scale), vec_new(1.f), zero)
+	};
+}
+
+/**
+ * @brief Approximate spherical linear interpolation of four quaternion pairs along the shortest path.
+ * @details The weights `sin((1 - t) theta) / sin(theta)` and `sin(t theta) / sin(theta)` are
+ * evaluated as twelve term polynomials in `cos(theta)`, without arc cosine, sine or division, after
+ * David Eberly's "A Fast and Accurate Algorithm for Computing SLERP". The maximum error
+ * against quat_slerp is about `1e-6` for all angles, including nearly parallel quaternions.
+ * @param t The four interpolation fractions.
+ * @see quat_slerp
+ */
+static quatx4 quatx4_slerp(const quatx4 a, const quatx4 b, const vec t) {
+
+	// u[i] = 1 / (i (2i + 1)), v[i] = i / (2i + 1), with the last term corrected by mu
+	static const float mu = 1.89372f;
+	static const float u[12] = {
+		1.f / (1 * 3), 1.f / (2 * 5), 1.f / (3 * 7), 1.f / (4 * 9), 1.f / (5 * 11), 1.f / (6 * 13),
+		1.f / (7 * 15), 1.f / (8 * 17), 1.f / (9 * 19), 1.f / (10 * 21), 1.f / (11 * 23), mu / (12 * 25)
+	};
+	static const float v[12] = {
+		1.f / 3, 2.f / 5, 3.f / 7, 4.f / 9, 5.f / 11, 6.f / 13,
+		7.f / 15, 8.f / 17, 9.f / 19, 10.f / 21, 11.f / 23, mu * 12 / 25
+	};
+
+	const vec dot = quatx4_dot(a, b);
+	const vec sign = _mm_and_ps(dot, vec_new(-0.f));
+	const vec x_1 = vec_subtract(_mm_xor_ps(dot, sign), vec_new(1.f));
+
+	const vec d = vec_subtract(vec_new(1.f), t);
+	const vec t2 = vec_multiply(t, t);
+	const vec d2 = vec_multiply(d, d);
+
+	vec ft = vec_new(1.f), fd = vec_new(1.f);
+	for (int i = 11; i >= 0; i--) {
+		const vec bt = vec_multiply(vec_subtract(vec_scale(t2, u[i]), vec_new(v[i])), x_1);
+		const vec bd = vec_multiply(vec_subtract(vec_scale(d2, u[i]), vec_new(v[i])), x_1);
+		ft = vec_add(vec_new(1.f), vec_multiply(bt, ft));
+		fd = vec_add(vec_new(1.f), vec_multiply(bd, fd));
+	}
+
+	const vec wa = vec_multiply(d, fd);
+	const vec wb = _mm_xor_ps(vec_multiply(t, ft), sign);
+
+	return (quatx4) {
+		vec_add(vec_multiply(a.x, wa), vec_multiply(b.x, wb)),
+		vec_add(vec_multiply(a.y, wa), vec_multiply(b.y, wb)),
+		vec_add(vec_multiply(a.z, wa), vec_multiply(b.z, wb)),
+		vec_add(vec_multiply(a.w, wa), vec_multiply(b.w, wb))
+	};
+}
+
+/**
+ * @brief Calculates the three smallest components of four unit quaternions.
+ * @details Each quaternion is negated if necessary so that its largest component is positive.
+ * @param index The indices of the largest components.
+ * @return The remaining components, in order, each within `[-1 / sqrt(2), 1 / sqrt(2)]`.
+ */
+static vec3x4 quatx4_smallest_three(const quatx4 q, ivec *index) {
+
+	const vec abs = vec_new(-0.f);
+
+	const vec ax = _mm_andnot_ps(abs, q.x);
+	const vec ay = _mm_andnot_ps(abs, q.y);
+	const vec az = _mm_andnot_ps(abs, q.z);
+	const vec aw = _mm_andnot_ps(abs, q.w);
+
+	const vec gy = _mm_cmpgt_ps(ay, ax);
+	const vec my = vec_max(ax, ay);
+	const vec gz = _mm_cmpgt_ps(az, my);
+	const vec mz = vec_max(my, az);
+	const vec gw = _mm_cmpgt_ps(aw, mz);
+
+	ivec i = ivec0();
+	i = _mm_blendv_epi8(i, ivec_new(1), ivec_cast_vec(gy));
+	i = _mm_blendv_epi8(i, ivec_new(2), ivec_cast_vec(gz));
+	i = _mm_blendv_epi8(i, ivec_new(3), ivec_cast_vec(gw));
+
+	vec largest = q.x;
+	largest = _mm_blendv_ps(largest, q.y, gy);
+	largest = _mm_blendv_ps(largest, q.z, gz);
+	largest = _mm_blendv_ps(largest, q.w, gw);
+
+	const vec sign = _mm_and_ps(largest, abs);
+
+	const vec i0 = vec_cast_ivec(ivec_compare_eq(i, ivec_new(0)));
+	const vec i3 = vec_cast_ivec(ivec_compare_eq(i, ivec_new(3)));
+	const vec i01 = vec_cast_ivec(ivec_compare_lt(i, ivec_new(2)));
+
+	*index = i;
+
+	return (vec3x4) {
+		_mm_xor_ps(_mm_blendv_ps(q.x, q.y, i0), sign),
+		_mm_xor_ps(_mm_blendv_ps(q.y, q.z, i01), sign),
+		_mm_xor_ps(_mm_blendv_ps(q.w, q.z, i3), sign)
+	};
+}
+
+/**
+ * @brief Stores the four quaternions @p q to consecutive quaternions at @p out.
+ */
+static void quatx4_store(const quatx4 q, quat *out) {
+
+	vec x = q.x, y = q.y, z = q.z, w = q.w;
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	out[0] = x;
+	out[1] = y;
+	out[2] = z;
+	out[3] = w;
+}
+
+/**
+ * @brief Compresses the unit quaternion @p q by the smallest three method.
+ * @return The compressed quaternion.
+ */
+static quat32 quat32_convert_quat(const quat q) {
+	const quatx4 q4 = {
+		_mm_shuffle_ps(q, q, 0x00),
+		_mm_shuffle_ps(q, q, 0x55),
+		_mm_shuffle_ps(q, q, 0xAA),
+		_mm_shuffle_ps(q, q, 0xFF)
+	};
+	return (quat32) _mm_cvtsi128_si32(quat32_convert_quatx4(q4));
+}
+
+/**
+ * @brief Compresses @p count unit quaternions by the smallest three method, four at a time.
+ * @param out The compressed quaternions, which need not be aligned.
+ */
+static void quat32_convert_quat_array(quat32 *out, const quat *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_si128((__m128i *) (out + i), quat32_convert_quatx4(quatx4_load(in + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat32_convert_quat(in[i]);
+	}
+}
+
+/**
+ * @brief Compresses four unit quaternions by the smallest three method.
+ * @return The four compressed quaternions.
+ */
+static ivec quat32_convert_quatx4(const quatx4 q) {
+
+	ivec index;
+	const vec3x4 v = quatx4_smallest_three(q, &index);
+
+	const vec scale = vec_new(1022 * M_SQRT2 * .5);
+	const vec bias = vec_new(1022 * .5);
+
+	const ivec max = ivec_new(1022);
+
+	const ivec a = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.x, scale), bias)), ivec0()), max);
+	const ivec b = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.y, scale), bias)), ivec0()), max);
+	const ivec c = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.z, scale), bias)), ivec0()), max);
+
+	return _mm_or_si128(
+		_mm_or_si128(_mm_slli_epi32(index, 30), _mm_slli_epi32(a, 20)),
+		_mm_or_si128(_mm_slli_epi32(b, 10), c)
+	);
+}
+
+/**
+ * @brief Compresses the unit quaternion @p q by the smallest three method.
+ * @return The compressed quaternion.
+ */
+static quat48 quat48_convert_quat(const quat q) {
+	const quatx4 q4 = {
+		_mm_shuffle_ps(q, q, 0x00),
+		_mm_shuffle_ps(q, q, 0x55),
+		_mm_shuffle_ps(q, q, 0xAA),
+		_mm_shuffle_ps(q, q, 0xFF)
+	};
+
+	ivec a, b, c;
+	quat48_convert_quatx4(q4, &a, &b, &c);
+
+	return (quat48) {
+		.v = {
+			(uint16_t) _mm_cvtsi128_si32(a),
+			(uint16_t) _mm_cvtsi128_si32(b),
+			(uint16_t) _mm_cvtsi128_si32(c)
+		}
+	};
+}
+
+/**
+ * @brief Compresses @p count unit quaternions by the smallest three method, four at a time.
+ * @param out The compressed quaternions.
+ */
+static void quat48_convert_quat_array(quat48 *out, const quat *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+
+		ivec a, b, c;
+		quat48_convert_quatx4(quatx4_load(in + i), &a, &b, &c);
+
+		// a0 a1 a2 a3 b0 b1 b2 b3 and c0 c1 c2 c3, interleaved to a0 b0 c0 a1 b1 c1 a2 b2 c2 a3 b3 c3
+		const ivec ab = _mm_packus_epi32(a, b);
+		const ivec cc = _mm_packus_epi32(c, c);
+
+		const ivec lo = _mm_or_si128(
+			_mm_shuffle_epi8(ab, _mm_setr_epi8(0, 1, 8, 9, -1, -1, 2, 3, 10, 11, -1, -1, 4, 5, 12, 13)),
+			_mm_shuffle_epi8(cc, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1)));
+		const ivec hi = _mm_or_si128(
+			_mm_shuffle_epi8(ab, _mm_setr_epi8(-1, -1, 6, 7, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+			_mm_shuffle_epi8(cc, _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1)));
+
+		_mm_storeu_si128((__m128i *) (out + i), lo);
+		_mm_storel_epi64((__m128i *) ((uint16_t *) (out + i) + 8), hi);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat48_convert_quat(in[i]);
+	}
+}
+
+/**
+ * @brief Compresses four unit quaternions by the smallest three method.
+ * @param a The first words of the four compressed quaternions.
+ * @param b The second words of the four compressed quaternions.
+ * @param c The third words of the four compressed quaternions.
+ */
+static void quat48_convert_quatx4(const quatx4 q, ivec *a, ivec *b, ivec *c) {
+
+	ivec index;
+	const vec3x4 v = quatx4_smallest_three(q, &index);
+
+	const vec scale = vec_new(32766 * M_SQRT2 * .5);
+	const vec bias = vec_new(32766 * .5);
+
+	const ivec max = ivec_new(32766);
+	const ivec one = ivec_new(1);
+
+	*a = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.x, scale), bias)), ivec0()), max);
+	*b = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.y, scale), bias)), ivec0()), max);
+	*c = ivec_min(ivec_max(_mm_cvtps_epi32(vec_add(vec_multiply(v.z, scale), bias)), ivec0()), max);
+
+	*a = _mm_or_si128(*a, _mm_slli_epi32(_mm_and_si128(index, one), 15));
+	*b = _mm_or_si128(*b, _mm_slli_epi32(_mm_srli_epi32(index, 1), 15));
+}
+
+/**
+ * @brief Compresses the unit quaternion @p q to signed normalized components.
+ * @return The compressed quaternion.
+ */
+static quat64 quat64_convert_quat(const quat q) {
+	const ivec i = _mm_cvtps_epi32(vec_scale(q, 32767));
+
+	quat64 p;
+	_mm_storel_epi64((__m128i *) p.v, _mm_packs_epi32(i, i));
+	return p;
+}
+
+/**
+ * @brief Compresses @p count unit quaternions to signed normalized components, four at a time.
+ * @param out The compressed quaternions, which need not be aligned.
+ */
+static void quat64_convert_quat_array(quat64 *out, const quat *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec a = _mm_cvtps_epi32(vec_scale(in[i + 0], 32767));
+		const ivec b = _mm_cvtps_epi32(vec_scale(in[i + 1], 32767));
+		const ivec c = _mm_cvtps_epi32(vec_scale(in[i + 2], 32767));
+		const ivec d = _mm_cvtps_epi32(vec_scale(in[i + 3], 32767));
+
+		_mm_storeu_si128((__m128i *) (out + i), _mm_packs_epi32(a, b));
+		_mm_storeu_si128((__m128i *) (out + i + 2), _mm_packs_epi32(c, d));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = quat64_convert_quat(in[i]);
+	}
+}
@@ -23,7 +23,12 @@
 
 #pragma once
 
+#include "cpu.h"
+#include "dvec.h"
 #include "ivec.h"
 #include "mat.h"
 #include "quat.h"
+#include "random.h"
 #include "vec.h"
+#include "vec8.h"
+#include "vec16.h"
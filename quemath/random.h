@@ -0,0 +1,351 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "vec.h"
+
+/**
+ * @brief Four independent _xoshiro128++_ streams, one per lane.
+ * @details Each lane is seeded `2^64` steps ahead of the last, so the lanes never overlap
+ * unless a single lane draws more than `2^64` values.
+ */
+typedef struct {
+	/**
+	 * @brief The state words, each holding one word of all four streams.
+	 */
+	ivec s[4];
+} random4;
+
+/**
+ * @brief Eight independent _xoshiro128++_ streams, as two interleaved groups of four.
+ * @details Advancing both groups together hides the latency of each group's dependency chain.
+ */
+typedef struct {
+	/**
+	 * @brief Lanes `0 - 3` and `4 - 7`.
+	 */
+	random4 a, b;
+} random8;
+
+static inline void random4_fill(random4 *r, uint32_t *out, size_t count);
+static inline void random4_fill_float(random4 *r, float *out, size_t count);
+static inline void random4_jump(random4 *r);
+static inline void random4_jump_polynomial(random4 *r, const uint32_t polynomial[4]);
+static inline void random4_long_jump(random4 *r);
+static inline random4 random4_new(uint64_t seed);
+static inline ivec random4_next(random4 *r);
+static inline vec random4_next_float(random4 *r);
+static inline vec random4_next_float_range(random4 *r, const vec mins, const vec maxs);
+static inline ivec random4_next_range(random4 *r, const ivec mins, const ivec maxs);
+static inline ivec random4_next_range_unbiased(random4 *r, const ivec mins, const ivec maxs);
+
+static inline void random8_fill(random8 *r, uint32_t *out, size_t count);
+static inline void random8_fill_float(random8 *r, float *out, size_t count);
+static inline void random8_long_jump(random8 *r);
+static inline random8 random8_new(uint64_t seed);
+
+/**
+ * @brief Fills @p out with @p count random integers, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void random4_fill(random4 *r, uint32_t *out, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_si128((__m128i *) (out + i), random4_next(r));
+	}
+	if (batch < count) {
+		const ivec last = random4_next(r);
+		memcpy(out + batch, &last, (count - batch) * sizeof(uint32_t));
+	}
+}
+
+/**
+ * @brief Fills @p out with @p count random values in `[0, 1)`, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void random4_fill_float(random4 *r, float *out, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_ps(out + i, random4_next_float(r));
+	}
+	if (batch < count) {
+		const vec last = random4_next_float(r);
+		memcpy(out + batch, &last, (count - batch) * sizeof(float));
+	}
+}
+
+/**
+ * @brief Advances every lane of @p r by `2^64` steps.
+ * @details Since the lanes of @p r are `2^64` steps apart, this moves each lane onto the start
+ * of the next lane's stream. Use random4_long_jump to hand independent streams to threads.
+ */
+static void random4_jump(random4 *r) {
+	static const uint32_t jump[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+	random4_jump_polynomial(r, jump);
+}
+
+/**
+ * @brief Advances every lane of @p r by @p polynomial, in jumps of `2^64` or `2^96` steps.
+ */
+static void random4_jump_polynomial(random4 *r, const uint32_t polynomial[4]) {
+
+	ivec s0 = ivec0(), s1 = ivec0(), s2 = ivec0(), s3 = ivec0();
+
+	for (int i = 0; i < 4; i++) {
+		for (int b = 0; b < 32; b++) {
+			if (polynomial[i] & (1u << b)) {
+				s0 = _mm_xor_si128(s0, r->s[0]);
+				s1 = _mm_xor_si128(s1, r->s[1]);
+				s2 = _mm_xor_si128(s2, r->s[2]);
+				s3 = _mm_xor_si128(s3, r->s[3]);
+			}
+			random4_next(r);
+		}
+	}
+
+	r->s[0] = s0;
+	r->s[1] = s1;
+	r->s[2] = s2;
+	r->s[3] = s3;
+}
+
+/**
+ * @brief Advances every lane of @p r by `2^96` steps.
+ * @details Each call yields a generator that does not overlap @p r for `2^32` calls, so a
+ * seeded generator may be copied and long jumped once per worker thread.
+ */
+static void random4_long_jump(random4 *r) {
+	static const uint32_t long_jump[4] = { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+	random4_jump_polynomial(r, long_jump);
+}
+
+/**
+ * @brief Creates a generator of four streams from @p seed.
+ * @details The seed is expanded with _SplitMix64_, so that similar seeds yield unrelated
+ * streams, and each lane is then jumped `2^64` steps ahead of the last.
+ * @return The generator.
+ */
+static random4 random4_new(uint64_t seed) {
+
+	uint32_t s[4];
+	for (int i = 0; i < 4; i += 2) {
+		uint64_t z = (seed += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		z = z ^ (z >> 31);
+
+		s[i + 0] = (uint32_t) z;
+		s[i + 1] = (uint32_t) (z >> 32);
+	}
+
+	random4 r = {
+		.s = { ivec_new((int) s[0]), ivec_new((int) s[1]), ivec_new((int) s[2]), ivec_new((int) s[3]) }
+	};
+
+	// jump every lane, keeping the results only in the lanes above the last one placed
+	for (int lane = 1; lane < 4; lane++) {
+		random4 jumped = r;
+		random4_jump(&jumped);
+
+		const ivec mask = _mm_cmpgt_epi32(ivec4i(0, 1, 2, 3), ivec_new(lane - 1));
+		for (int i = 0; i < 4; i++) {
+			r.s[i] = _mm_blendv_epi8(r.s[i], jumped.s[i], mask);
+		}
+	}
+
+	return r;
+}
+
+/**
+ * @brief Generates four random integers, one from each stream of @p r.
+ * @return An integer vector of four uniformly distributed 32 bit integers.
+ */
+static ivec random4_next(random4 *r) {
+
+	const ivec sum = _mm_add_epi32(r->s[0], r->s[3]);
+	const ivec result = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(sum, 7), _mm_srli_epi32(sum, 25)), r->s[0]);
+
+	const ivec t = _mm_slli_epi32(r->s[1], 9);
+
+	r->s[2] = _mm_xor_si128(r->s[2], r->s[0]);
+	r->s[3] = _mm_xor_si128(r->s[3], r->s[1]);
+	r->s[1] = _mm_xor_si128(r->s[1], r->s[2]);
+	r->s[0] = _mm_xor_si128(r->s[0], r->s[3]);
+	r->s[2] = _mm_xor_si128(r->s[2], t);
+	r->s[3] = _mm_or_si128(_mm_slli_epi32(r->s[3], 11), _mm_srli_epi32(r->s[3], 21));
+
+	return result;
+}
+
+/**
+ * @brief Generates four random values, one from each stream of @p r.
+ * @details The upper 24 bits of each integer are scaled exactly, so every value is a multiple
+ * of `2^-24`.
+ * @return A vector of four uniformly distributed values in `[0, 1)`.
+ */
+static vec random4_next_float(random4 *r) {
+	return vec_scale(vec_convert_ivec(_mm_srli_epi32(random4_next(r), 8)), 1.f / (1 << 24));
+}
+
+/**
+ * @brief Generates four random values in `[mins, maxs)`, one from each stream of @p r.
+ * @details The upper 23 bits of each integer become the mantissa of a value in `[1, 2)`, and
+ * results that round up to @p maxs are stepped down to the next representable value, so the
+ * upper bound is never returned.
+ * @param mins The lower bounds of the returned values (inclusive).
+ * @param maxs The upper bounds of the returned values (exclusive), greater than @p mins.
+ * @return A vector of four uniformly distributed values in `[mins, maxs)`.
+ */
+static vec random4_next_float_range(random4 *r, const vec mins, const vec maxs) {
+
+	const ivec bits = _mm_or_si128(_mm_srli_epi32(random4_next(r), 9), ivec_new(0x3f800000));
+	const vec unit = vec_subtract(_mm_castsi128_ps(bits), vec_new(1));
+
+	const vec v = vec_add(mins, vec_multiply(unit, vec_subtract(maxs, mins)));
+
+	// the largest value below maxs: away from zero by one ulp for negatives, toward it for positives
+	const ivec m = _mm_castps_si128(maxs);
+	const ivec step = _mm_blendv_epi8(ivec_new(1), ivec_new(-1), _mm_castps_si128(_mm_cmpgt_ps(maxs, vec0())));
+	const ivec below = _mm_blendv_epi8(_mm_add_epi32(m, step), ivec_new((int) 0x80000001),
+									   _mm_castps_si128(_mm_cmpeq_ps(maxs, vec0())));
+
+	return _mm_blendv_ps(v, _mm_castsi128_ps(below), _mm_cmpge_ps(v, maxs));
+}
+
+/**
+ * @brief Generates four random integers in `[mins, maxs)`, one from each stream of @p r.
+ * @details Each integer is mapped onto the range by the high half of its product with the range,
+ * after Lemire, which avoids division entirely. Some values are more likely than others by at
+ * most `(maxs - mins) / 2^32`. Use random4_next_range_unbiased when that matters.
+ * @param mins The lower bounds of the returned integers (inclusive).
+ * @param maxs The upper bounds of the returned integers (exclusive). The range `maxs - mins` is
+ * taken as unsigned, so any range up to `2^32 - 1` is supported.
+ * @return An integer vector of four random integers in `[mins, maxs)`.
+ */
+static ivec random4_next_range(random4 *r, const ivec mins, const ivec maxs) {
+	return ivec_add(mins, ivec_multiply_high_unsigned(random4_next(r), ivec_subtract(maxs, mins)));
+}
+
+/**
+ * @brief Generates four uniformly distributed integers in `[mins, maxs)`, one from each stream of @p r.
+ * @details Like random4_next_range, but lanes whose low product falls within the `2^32 % range`
+ * values that cause the bias are drawn again. The modulo is only evaluated when a lane's low
+ * product is below the range, which is rare for small ranges.
+ * @see random4_next_range
+ * @return An integer vector of four uniformly distributed integers in `[mins, maxs)`.
+ */
+static ivec random4_next_range_unbiased(random4 *r, const ivec mins, const ivec maxs) {
+
+	const ivec range = ivec_subtract(maxs, mins);
+	const ivec sign = ivec_new((int) 0x80000000);
+
+	ivec result = ivec0(), pending = ivec_true();
+	ivec threshold = ivec0();
+	int thresholds = 0;
+
+	while (!_mm_testz_si128(pending, pending)) {
+		const ivec x = random4_next(r);
+
+		const ivec high = ivec_multiply_high_unsigned(x, range);
+		const ivec low = _mm_mullo_epi32(x, range);
+
+		result = _mm_blendv_epi8(result, high, pending);
+
+		// unsigned comparisons of low with the range, and then with the threshold
+		ivec reject = _mm_and_si128(pending, _mm_cmplt_epi32(_mm_xor_si128(low, sign), _mm_xor_si128(range, sign)));
+		if (!_mm_testz_si128(reject, reject)) {
+			if (!thresholds) {
+				uint32_t t[4];
+				_mm_storeu_si128((__m128i *) t, range);
+				for (int i = 0; i < 4; i++) {
+					t[i] = t[i] ? (0u - t[i]) % t[i] : 0;
+				}
+				threshold = _mm_loadu_si128((const __m128i *) t);
+				thresholds = 1;
+			}
+			reject = _mm_and_si128(reject, _mm_cmplt_epi32(_mm_xor_si128(low, sign), _mm_xor_si128(threshold, sign)));
+		}
+
+		pending = reject;
+	}
+
+	return ivec_add(mins, result);
+}
+
+/**
+ * @brief Fills @p out with @p count random integers, eight at a time.
+ * @details The output interleaves the two groups of @p r, four values at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void random8_fill(random8 *r, uint32_t *out, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		_mm_storeu_si128((__m128i *) (out + i + 0), random4_next(&r->a));
+		_mm_storeu_si128((__m128i *) (out + i + 4), random4_next(&r->b));
+	}
+	random4_fill(&r->a, out + batch, count - batch);
+}
+
+/**
+ * @brief Fills @p out with @p count random values in `[0, 1)`, eight at a time.
+ * @details The output interleaves the two groups of @p r, four values at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void random8_fill_float(random8 *r, float *out, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		_mm_storeu_ps(out + i + 0, random4_next_float(&r->a));
+		_mm_storeu_ps(out + i + 4, random4_next_float(&r->b));
+	}
+	random4_fill_float(&r->a, out + batch, count - batch);
+}
+
+/**
+ * @brief Advances every lane of @p r by `2^96` steps.
+ * @see random4_long_jump
+ */
+static void random8_long_jump(random8 *r) {
+	random4_long_jump(&r->a);
+	random4_long_jump(&r->b);
+}
+
+/**
+ * @brief Creates a generator of eight streams from @p seed.
+ * @details Lanes `4 - 7` continue `2^64` steps apart from lanes `0 - 3`, so no two lanes overlap.
+ * @return The generator.
+ */
+static random8 random8_new(uint64_t seed) {
+
+	random8 r = { .a = random4_new(seed) };
+
+	r.b = r.a;
+	for (int i = 0; i < 4; i++) {
+		random4_jump(&r.b);
+	}
+
+	return r;
+}
@@ -23,6 +23,10 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cpu.h"
 #include "ivec.h"
 
 /**
@@ -31,6 +35,53 @@
  * @{
  */
 
+/**
+ * @brief The hardware estimate, with a relative error of at most `1.5 * 2^-12`.
+ */
+#define QUEMATH_PRECISION_ESTIMATE 0
+
+/**
+ * @brief The hardware estimate refined by one Newton-Raphson step, to within three ULP for the
+ * reciprocal and four for the inverse square root.
+ */
+#define QUEMATH_PRECISION_REFINED 1
+
+/**
+ * @brief Division and square root. The reciprocal is correctly rounded, and the inverse square
+ * root, which rounds twice, is within 1.5 ULP.
+ */
+#define QUEMATH_PRECISION_PRECISE 2
+
+/**
+ * @brief The precision tier of vec_rcp, vec_rsqrt, and the functions built upon them, such as
+ * vec_divide_fast and vec_normalize_fast.
+ * @details Defaults to QUEMATH_PRECISION_REFINED. Call the `_estimate`, `_refined` or `_precise`
+ * variants directly to select a tier for a single call.
+ */
+#if !defined(QUEMATH_PRECISION)
+ #define QUEMATH_PRECISION QUEMATH_PRECISION_REFINED
+#endif
+
+/**
+ * @brief Dot products by the SSE4.1 dot product instruction, `_mm_dp_ps`.
+ */
+#define QUEMATH_DOT_DPPS 0
+
+/**
+ * @brief Dot products by multiplication and a reduction of two shuffles and two additions.
+ */
+#define QUEMATH_DOT_SHUFFLE 1
+
+/**
+ * @brief The implementation of vec_dot2, vec_dot3, vec_dot4, and the functions built upon them,
+ * such as vec_length and vec_normalize.
+ * @details Defaults to QUEMATH_DOT_SHUFFLE, which has higher throughput than `_mm_dp_ps` at similar
+ * latency; see the benchmark.
+ */
+#if !defined(QUEMATH_DOT)
+ #define QUEMATH_DOT QUEMATH_DOT_SHUFFLE
+#endif
+
 /**
  * @brief Two component floating point vector type.
  */
@@ -82,14 +133,77 @@ typedef union {
 	};
 } vec4;
 
+/**
+ * @brief Half precision floating point type, in IEEE 754 binary16 storage.
+ */
+typedef uint16_t half;
+
+/**
+ * @brief Unit vectors in octahedral encoding, as two 8 bit signed normalized components.
+ * @details The maximum angular error is `1` degree.
+ */
+typedef uint16_t oct16;
+
+/**
+ * @brief Unit vectors in octahedral encoding, as two 16 bit signed normalized components.
+ * @details The maximum angular error is `0.004` degrees.
+ */
+typedef uint32_t oct32;
+
+/**
+ * @brief Vectors as four 8 bit signed normalized components.
+ * @details The maximum component error is `1 / 254` within `[-1, 1]`.
+ */
+typedef uint32_t snorm32;
+
+/**
+ * @brief Vectors as four 16 bit signed normalized components.
+ * @details The maximum component error is `1 / 65534` within `[-1, 1]`.
+ */
+typedef struct {
+	int16_t v[4];
+} snorm64;
+
 /**
  * @brief Four component floating point SSE vector type.
  */
 typedef __m128 vec;
 
+/**
+ * @brief Four three component floating point vectors in structure of arrays form.
+ * @details Each register holds one component of four vectors, so that the dot product,
+ * cross product and friends are evaluated for all four vectors without shuffling.
+ */
+typedef struct {
+	/**
+	 * @brief Component accessors.
+	 */
+	vec x, y, z;
+} vec3x4;
+
+static inline ivec half_convert_vec(const vec v);
+static inline void half_convert_vec_array(half *out, const float *in, size_t count);
+static inline void half_convert_vec_array_sse(half *out, const float *in, size_t count);
+static inline ivec half_convert_vec_soft(const vec v);
+static inline void half_convert_vec2_array(half *out, const vec2 *in, size_t count);
+static inline void half_convert_vec3_array(half *out, const vec3 *in, size_t count);
+static inline void half_convert_vec4_array(half *out, const vec4 *in, size_t count);
+
 static inline ivec ivec_cast_vec(const vec v);
 static inline ivec ivec_convert_vec(const vec v);
 
+static inline oct16 oct16_convert_vec(const vec v);
+static inline void oct16_convert_vec3_array(oct16 *out, const vec3 *in, size_t count);
+static inline ivec oct16_convert_vec3x4(const vec3x4 v);
+static inline oct32 oct32_convert_vec(const vec v);
+static inline void oct32_convert_vec3_array(oct32 *out, const vec3 *in, size_t count);
+static inline ivec oct32_convert_vec3x4(const vec3x4 v);
+
+static inline snorm32 snorm32_convert_vec(const vec v);
+static inline void snorm32_convert_vec4_array(snorm32 *out, const vec4 *in, size_t count);
+static inline snorm64 snorm64_convert_vec(const vec v);
+static inline void snorm64_convert_vec4_array(snorm64 *out, const vec4 *in, size_t count);
+
 static inline vec vec0(void);
 static inline vec vec1f(float x);
 static inline vec vec2f(float x, float y);
@@ -104,15 +218,28 @@ static inline vec vec_asinf(const vec v);
 static inline vec vec_atanf(const vec v);
 static inline vec vec_atan2f(const vec a, const vec b);
 static inline vec vec_cast_ivec(const ivec v);
+static inline vec vec_convert_half(const ivec h);
+static inline void vec_convert_half_array(float *out, const half *in, size_t count);
+static inline void vec_convert_half_array_sse(float *out, const half *in, size_t count);
+static inline vec vec_convert_half_soft(const ivec h);
 static inline vec vec_convert_ivec(const ivec v);
+static inline vec vec_convert_oct16(const oct16 o);
+static inline vec vec_convert_oct32(const oct32 o);
+static inline vec vec_convert_snorm32(const snorm32 s);
+static inline vec vec_convert_snorm64(const snorm64 s);
 static inline vec vec_cosf(const vec v);
+static inline vec vec_cosf_fast(const vec v);
 static inline vec vec_cross(const vec a, const vec b);
 static inline vec vec_degrees(const vec radians);
 static inline vec vec_distance(const vec a, const vec b);
 static inline vec vec_divide(const vec a, const vec b);
+static inline vec vec_divide_fast(const vec a, const vec b);
 static inline vec vec_dot2(const vec a, const vec b);
 static inline vec vec_dot3(const vec a, const vec b);
+static inline vec vec_dot3_broadcast(const vec a, const vec b);
+static inline vec vec_dot3x4(const vec a[4], const vec b[4]);
 static inline vec vec_dot4(const vec a, const vec b);
+static inline vec vec_dot4_broadcast(const vec a, const vec b);
 static inline ivec vec_compare_eq(const vec a, const vec b);
 static inline ivec vec_compare_ge(const vec a, const vec b);
 static inline ivec vec_compare_gt(const vec a, const vec b);
@@ -122,6 +249,7 @@ static inline ivec vec_compare_ne(const vec a, const vec b);
 static inline int vec_equal(const vec a, const vec b);
 static inline int vec_greater_than(const vec a, const vec b);
 static inline int vec_greater_than_equal(const vec a, const vec b);
+static inline vec vec_horizontal_add(const vec v);
 static inline vec vec_length(const vec v);
 static inline int vec_less_than(const vec a, const vec b);
 static inline int vec_less_than_equal(const vec a, const vec b);
@@ -129,6 +257,8 @@ static inline vec vec_max(const vec a, const vec b);
 static inline vec vec_min(const vec a, const vec b);
 static inline vec vec_mix(const vec a, const vec b, float mix);
 static inline vec vec_multiply(const vec a, const vec b);
+static inline vec vec_multiply_add(const vec a, const vec b, const vec c);
+static inline vec vec_multiply_subtract(const vec a, const vec b, const vec c);
 static inline vec vec_negate(const vec v);
 static inline vec vec_new(float f);
 static inline vec vec_normalize(const vec v);
@@ -137,13 +267,34 @@ static inline int vec_not_equal(const vec a, const vec b);
 static inline vec vec_radians(const vec degrees);
 static inline vec vec_random(vec last);
 static inline vec vec_random_range(vec last, const vec mins, const vec maxs);
+static inline vec vec_rcp(const vec v);
+static inline vec vec_rcp_estimate(const vec v);
+static inline vec vec_rcp_precise(const vec v);
+static inline vec vec_rcp_refined(const vec v);
 static inline vec vec_rsqrt(const vec v);
+static inline vec vec_rsqrt_estimate(const vec v);
+static inline vec vec_rsqrt_precise(const vec v);
+static inline vec vec_rsqrt_refined(const vec v);
 static inline vec vec_scale(const vec v, float scale);
 static inline vec vec_scale_add(const vec a, const vec b, float scale);
+static inline void vec_sincosf(const vec v, vec *s, vec *c);
+static inline void vec_sincosf_array(float *s, float *c, const float *v, size_t count);
 static inline vec vec_sinf(const vec v);
+static inline vec vec_sinf_fast(const vec v);
 static inline vec vec_sqrt(const vec v);
 static inline vec vec_subtract(const vec a, const vec b);
 static inline vec vec_tanf(const vec v);
+static inline vec vec_tanf_fast(const vec v);
+static inline vec vec_trig_asin(const vec x);
+static inline vec vec_trig_atan(const vec x);
+static inline vec vec_trig_cos(const vec r);
+static inline vec vec_trig_cos_fast(const vec r);
+static inline ivec vec_trig_quadrant(const vec v);
+static inline vec vec_trig_reduce(const vec v, const ivec quadrant);
+static inline vec vec_trig_select(const ivec quadrant, const vec s, const vec c);
+static inline vec vec_trig_sin(const vec r);
+static inline vec vec_trig_sin_fast(const vec r);
+static inline vec vec_trig_tan(const vec r);
 static inline vec2 vec_vec2(const vec v);
 static inline vec3 vec_vec3(const vec v);
 static inline vec4 vec_vec4(const vec v);
@@ -155,6 +306,168 @@ static inline vec vec_yzx(const vec v);
 static inline float vec_z(const vec v);
 static inline vec vec_zxy(const vec v);
 
+static inline void vec2_convert_half_array(vec2 *out, const half *in, size_t count);
+
+static inline void vec3_add_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_add_array_sse(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_convert_half_array(vec3 *out, const half *in, size_t count);
+static inline void vec3_convert_oct16_array(vec3 *out, const oct16 *in, size_t count);
+static inline void vec3_convert_oct32_array(vec3 *out, const oct32 *in, size_t count);
+static inline void vec3_cross_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_cross_array_sse(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_distance_array(float *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_distance_array_sse(float *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_dot3_array(float *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_dot3_array_sse(float *out, const vec3 *a, const vec3 *b, size_t count);
+static inline void vec3_length_array(float *out, const vec3 *v, size_t count);
+static inline void vec3_length_array_sse(float *out, const vec3 *v, size_t count);
+static inline void vec3_normalize_array(vec3 *out, const vec3 *v, size_t count);
+static inline void vec3_normalize_array_sse(vec3 *out, const vec3 *v, size_t count);
+static inline void vec3_scale_add_array(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count);
+static inline void vec3_scale_add_array_sse(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count);
+
+#if QUEMATH_AVX2
+static inline void vec3_add_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_cross_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_distance_array_avx2(float *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_dot3_array_avx2(float *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_length_array_avx2(float *out, const vec3 *v, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_normalize_array_avx2(vec3 *out, const vec3 *v, size_t count) QUEMATH_TARGET_AVX2;
+static inline void vec3_scale_add_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) QUEMATH_TARGET_AVX2;
+#endif
+
+#if QUEMATH_AVX512
+static inline void vec3_add_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_cross_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_distance_array_avx512(float *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_dot3_array_avx512(float *out, const vec3 *a, const vec3 *b, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_length_array_avx512(float *out, const vec3 *v, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_normalize_array_avx512(vec3 *out, const vec3 *v, size_t count) QUEMATH_TARGET_AVX512;
+static inline void vec3_scale_add_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) QUEMATH_TARGET_AVX512;
+#endif
+
+#if QUEMATH_F16C
+static inline void half_convert_vec_array_f16c(half *out, const float *in, size_t count) QUEMATH_TARGET_F16C;
+static inline void vec_convert_half_array_f16c(float *out, const half *in, size_t count) QUEMATH_TARGET_F16C;
+#endif
+
+static inline vec3x4 vec3x4_add(const vec3x4 a, const vec3x4 b);
+static inline vec3x4 vec3x4_convert_oct16(const ivec o);
+static inline vec3x4 vec3x4_convert_oct32(const ivec o);
+static inline vec3x4 vec3x4_cross(const vec3x4 a, const vec3x4 b);
+static inline vec vec3x4_distance(const vec3x4 a, const vec3x4 b);
+static inline vec vec3x4_dot3(const vec3x4 a, const vec3x4 b);
+static inline vec vec3x4_length(const vec3x4 v);
+static inline vec3x4 vec3x4_load(const vec3 *v);
+static inline vec3x4 vec3x4_normalize(const vec3x4 v);
+static inline vec3x4 vec3x4_oct_decode(const vec u, const vec v);
+static inline void vec3x4_oct_encode(const vec3x4 n, vec *u, vec *v);
+static inline vec3x4 vec3x4_scale(const vec3x4 v, float scale);
+static inline vec3x4 vec3x4_scale_add(const vec3x4 a, const vec3x4 b, float scale);
+static inline void vec3x4_store(const vec3x4 v, vec3 *out);
+static inline vec3x4 vec3x4_subtract(const vec3x4 a, const vec3x4 b);
+
+static inline void vec4_convert_half_array(vec4 *out, const half *in, size_t count);
+static inline void vec4_convert_snorm32_array(vec4 *out, const snorm32 *in, size_t count);
+static inline void vec4_convert_snorm64_array(vec4 *out, const snorm64 *in, size_t count);
+
+/**
+ * @brief Converts the four components of @p v to half precision, rounding to nearest even.
+ * @details F16C is used where it is part of the minimum instruction set, and is bit exact with
+ * half_convert_vec_soft. The array conversions also select F16C at run time.
+ * @return The four half precision components in the low 64 bits, and zero in the high.
+ */
+static ivec half_convert_vec(const vec v) {
+#if defined(__F16C__)
+	return _mm_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT);
+#else
+	return half_convert_vec_soft(v);
+#endif
+}
+
+/**
+ * @brief Converts @p count floats to half precision.
+ * @details Runs eight at a time with F16C where it is supported.
+ * @param out The output array, which need not be aligned.
+ * @param in The input array, which need not be aligned.
+ */
+static void half_convert_vec_array(half *out, const float *in, size_t count) {
+
+#if QUEMATH_F16C
+	if (count >= 8 && cpu_has_f16c()) {
+		half_convert_vec_array_f16c(out, in, count);
+		return;
+	}
+#endif
+
+	half_convert_vec_array_sse(out, in, count);
+}
+
+/**
+ * @brief Converts @p count floats to half precision, four at a time.
+ * @see half_convert_vec_array
+ */
+static void half_convert_vec_array_sse(half *out, const float *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storel_epi64((__m128i *) (out + i), half_convert_vec(_mm_loadu_ps(in + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = (half) _mm_extract_epi16(half_convert_vec(vec1f(in[i])), 0);
+	}
+}
+
+/**
+ * @brief Converts the four components of @p v to half precision without F16C.
+ * @details Overflow yields infinity, and NaN is quieted with its payload truncated, as by F16C.
+ * @return The four half precision components in the low 64 bits, and zero in the high.
+ */
+static ivec half_convert_vec_soft(const vec v) {
+
+	const ivec f = ivec_cast_vec(v);
+	const ivec sign = _mm_and_si128(f, ivec_new(0x80000000));
+	const ivec a = _mm_xor_si128(f, sign);
+
+	// normal results rebias the exponent, and round to nearest even by adding 0xfff plus the lsb
+	// 0xc8000fff is ((15 - 127) << 23) + 0xfff, without shifting a negative integer
+	const ivec lsb = _mm_and_si128(_mm_srli_epi32(a, 13), ivec_new(1));
+	const ivec normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(a, ivec_new((int) 0xc8000fff)), lsb), 13);
+
+	// subnormal results are rounded by the floating point add, aligning the result to the low bits
+	const vec magic = vec_cast_ivec(ivec_new((127 - 15 + 23 - 10 + 1) << 23));
+	const ivec subnormal = _mm_sub_epi32(ivec_cast_vec(vec_add(vec_cast_ivec(a), magic)), ivec_cast_vec(magic));
+
+	const ivec nan = _mm_or_si128(ivec_new(0x7e00), _mm_and_si128(_mm_srli_epi32(a, 13), ivec_new(0x3ff)));
+	const ivec special = _mm_blendv_epi8(ivec_new(0x7c00), nan, _mm_cmpgt_epi32(a, ivec_new(0x7f800000)));
+
+	ivec h = _mm_blendv_epi8(normal, subnormal, _mm_cmplt_epi32(a, ivec_new(113 << 23)));
+	h = _mm_blendv_epi8(h, special, _mm_cmpgt_epi32(a, ivec_new(((127 + 16) << 23) - 1)));
+	h = _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+
+	return _mm_packus_epi32(h, ivec0());
+}
+
+/**
+ * @brief Converts @p count two component vectors to packed half precision, four bytes each.
+ */
+static void half_convert_vec2_array(half *out, const vec2 *in, size_t count) {
+	half_convert_vec_array(out, (const float *) in, count * 2);
+}
+
+/**
+ * @brief Converts @p count three component vectors to packed half precision, six bytes each.
+ */
+static void half_convert_vec3_array(half *out, const vec3 *in, size_t count) {
+	half_convert_vec_array(out, (const float *) in, count * 3);
+}
+
+/**
+ * @brief Converts @p count four component vectors to packed half precision, eight bytes each.
+ */
+static void half_convert_vec4_array(half *out, const vec4 *in, size_t count) {
+	half_convert_vec_array(out, (const float *) in, count * 4);
+}
+
 /**
  * @brief Casts the floating point bit pattern of @p v to an integer vector.
  * @return The floating point bit pattern of @p v cast to an integer vector.
@@ -171,6 +484,152 @@ static ivec ivec_convert_vec(const vec v) {
 	return _mm_cvtps_epi32(v);
 }
 
+/**
+ * @brief Encodes the unit vector @p v in octahedral form at 8 bits per component.
+ * @return The encoded vector.
+ */
+static oct16 oct16_convert_vec(const vec v) {
+	const vec3x4 n = { _mm_shuffle_ps(v, v, 0x00), _mm_shuffle_ps(v, v, 0x55), _mm_shuffle_ps(v, v, 0xAA) };
+	return (oct16) _mm_extract_epi16(oct16_convert_vec3x4(n), 0);
+}
+
+/**
+ * @brief Encodes @p count unit vectors in octahedral form at 8 bits per component, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void oct16_convert_vec3_array(oct16 *out, const vec3 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storel_epi64((__m128i *) (out + i), oct16_convert_vec3x4(vec3x4_load(in + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = oct16_convert_vec(vec3fv(in[i]));
+	}
+}
+
+/**
+ * @brief Encodes four unit vectors in octahedral form at 8 bits per component.
+ * @return The four encoded vectors in the low 64 bits.
+ */
+static ivec oct16_convert_vec3x4(const vec3x4 v) {
+
+	vec u, w;
+	vec3x4_oct_encode(v, &u, &w);
+
+	const ivec x = _mm_cvtps_epi32(vec_scale(u, 127));
+	const ivec y = _mm_cvtps_epi32(vec_scale(w, 127));
+
+	const ivec o = _mm_or_si128(_mm_and_si128(x, ivec_new(0xff)), _mm_slli_epi32(_mm_and_si128(y, ivec_new(0xff)), 8));
+	return _mm_packus_epi32(o, ivec0());
+}
+
+/**
+ * @brief Encodes the unit vector @p v in octahedral form at 16 bits per component.
+ * @return The encoded vector.
+ */
+static oct32 oct32_convert_vec(const vec v) {
+	const vec3x4 n = { _mm_shuffle_ps(v, v, 0x00), _mm_shuffle_ps(v, v, 0x55), _mm_shuffle_ps(v, v, 0xAA) };
+	return (oct32) _mm_cvtsi128_si32(oct32_convert_vec3x4(n));
+}
+
+/**
+ * @brief Encodes @p count unit vectors in octahedral form at 16 bits per component, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void oct32_convert_vec3_array(oct32 *out, const vec3 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_si128((__m128i *) (out + i), oct32_convert_vec3x4(vec3x4_load(in + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = oct32_convert_vec(vec3fv(in[i]));
+	}
+}
+
+/**
+ * @brief Encodes four unit vectors in octahedral form at 16 bits per component.
+ * @return The four encoded vectors.
+ */
+static ivec oct32_convert_vec3x4(const vec3x4 v) {
+
+	vec u, w;
+	vec3x4_oct_encode(v, &u, &w);
+
+	const ivec x = _mm_cvtps_epi32(vec_scale(u, 32767));
+	const ivec y = _mm_cvtps_epi32(vec_scale(w, 32767));
+
+	return _mm_or_si128(_mm_and_si128(x, ivec_new(0xffff)), _mm_slli_epi32(y, 16));
+}
+
+/**
+ * @brief Encodes the vector @p v as four 8 bit signed normalized components.
+ * @details Components outside of `[-1, 1]` are clamped.
+ * @return The encoded vector.
+ */
+static snorm32 snorm32_convert_vec(const vec v) {
+	const ivec i = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(v, vec_new(1)), vec_new(-1)), 127));
+	const ivec s = _mm_packs_epi32(i, i);
+	return (snorm32) _mm_cvtsi128_si32(_mm_packs_epi16(s, s));
+}
+
+/**
+ * @brief Encodes @p count vectors as four 8 bit signed normalized components, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void snorm32_convert_vec4_array(snorm32 *out, const vec4 *in, size_t count) {
+
+	const vec one = vec_new(1), minus_one = vec_new(-1);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec a = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 0]), one), minus_one), 127));
+		const ivec b = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 1]), one), minus_one), 127));
+		const ivec c = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 2]), one), minus_one), 127));
+		const ivec d = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 3]), one), minus_one), 127));
+
+		_mm_storeu_si128((__m128i *) (out + i), _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = snorm32_convert_vec(vec4fv(in[i]));
+	}
+}
+
+/**
+ * @brief Encodes the vector @p v as four 16 bit signed normalized components.
+ * @details Components outside of `[-1, 1]` are clamped.
+ * @return The encoded vector.
+ */
+static snorm64 snorm64_convert_vec(const vec v) {
+	const ivec i = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(v, vec_new(1)), vec_new(-1)), 32767));
+
+	snorm64 s;
+	_mm_storel_epi64((__m128i *) s.v, _mm_packs_epi32(i, i));
+	return s;
+}
+
+/**
+ * @brief Encodes @p count vectors as four 16 bit signed normalized components, four at a time.
+ * @param out The output array, which need not be aligned.
+ */
+static void snorm64_convert_vec4_array(snorm64 *out, const vec4 *in, size_t count) {
+
+	const vec one = vec_new(1), minus_one = vec_new(-1);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec a = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 0]), one), minus_one), 32767));
+		const ivec b = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 1]), one), minus_one), 32767));
+		const ivec c = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 2]), one), minus_one), 32767));
+		const ivec d = _mm_cvtps_epi32(vec_scale(vec_max(vec_min(vec4fv(in[i + 3]), one), minus_one), 32767));
+
+		_mm_storeu_si128((__m128i *) (out + i), _mm_packs_epi32(a, b));
+		_mm_storeu_si128((__m128i *) (out + i + 2), _mm_packs_epi32(c, d));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = snorm64_convert_vec(vec4fv(in[i]));
+	}
+}
+
 /**
  * @brief Creates a vector with all components initialized to zero.
  * @return A vector with all components initialized to zero.
@@ -237,10 +696,23 @@ static vec vec4fv(const vec4 f) {
 
 /**
  * @brief Calculates the arc cosine of @p v.
+ * @details The maximum error is 1 ULP.
  * @return A vector containing the arc cosine of @p v.
  */
 static vec vec_acosf(const vec v) {
-	return vec4f(acosf(vec_x(v)), acosf(vec_y(v)), acosf(vec_z(v)), acosf(vec_w(v)));
+
+	const vec sign = _mm_and_ps(v, vec_new(-0.f));
+	const vec a = _mm_xor_ps(v, sign);
+
+	const vec large = _mm_cmpgt_ps(a, vec_new(.5f));
+	const vec x = _mm_blendv_ps(a, vec_sqrt(vec_scale(vec_subtract(vec_new(1.f), a), .5f)), large);
+	const vec p = vec_trig_asin(x);
+
+	const vec small = vec_subtract(vec_new(M_PI_2), _mm_xor_ps(p, sign));
+	const vec pi = _mm_and_ps(_mm_cmplt_ps(v, vec0()), vec_new(M_PI));
+	const vec big = vec_add(pi, _mm_xor_ps(vec_add(p, p), sign));
+
+	return _mm_blendv_ps(small, big, large);
 }
 
 /**
@@ -253,29 +725,78 @@ static vec vec_add(const vec a, const vec b) {
 
 /**
  * @brief Calculates the arc sine of @p v.
+ * @details The maximum error is 2 ULP.
  * @return A vector containing the arc sine of @p v.
  */
 static vec vec_asinf(const vec v) {
-	return vec4f(asinf(vec_x(v)), asinf(vec_y(v)), asinf(vec_z(v)), asinf(vec_w(v)));
+
+	const vec sign = _mm_and_ps(v, vec_new(-0.f));
+	const vec a = _mm_xor_ps(v, sign);
+
+	const vec large = _mm_cmpgt_ps(a, vec_new(.5f));
+	const vec x = _mm_blendv_ps(a, vec_sqrt(vec_scale(vec_subtract(vec_new(1.f), a), .5f)), large);
+	const vec p = vec_trig_asin(x);
+
+	const vec r = _mm_blendv_ps(p, vec_subtract(vec_new(M_PI_2), vec_add(p, p)), large);
+	return _mm_xor_ps(r, sign);
 }
 
 /**
  * @brief Calculates the arc tangent of @p v.
+ * @details The maximum error is 3 ULP.
  * @return A vector containing the arc tangent of @p v.
  */
 static vec vec_atanf(const vec v) {
-	return vec4f(atanf(vec_x(v)), atanf(vec_y(v)), atanf(vec_z(v)), atanf(vec_w(v)));
+
+	const vec sign = _mm_and_ps(v, vec_new(-0.f));
+	const vec a = _mm_xor_ps(v, sign);
+
+	// reduce by atan(a) = π/4 + atan((a - 1) / (a + 1)) = π/2 + atan(-1 / a)
+	const vec mid = _mm_cmpgt_ps(a, vec_new(0.4142135623730950f));
+	const vec large = _mm_cmpgt_ps(a, vec_new(2.414213562373095f));
+
+	vec n = _mm_blendv_ps(a, vec_subtract(a, vec_new(1.f)), mid);
+	n = _mm_blendv_ps(n, vec_new(-1.f), large);
+
+	vec d = _mm_blendv_ps(vec_new(1.f), vec_add(a, vec_new(1.f)), mid);
+	d = _mm_blendv_ps(d, a, large);
+
+	vec r = _mm_blendv_ps(vec0(), vec_new(M_PI_4), mid);
+	r = _mm_blendv_ps(r, vec_new(M_PI_2), large);
+
+	return _mm_xor_ps(vec_add(r, vec_trig_atan(vec_divide(n, d))), sign);
 }
 
 /**
  * @brief Calculates the two argument arc tangent of @p a and @p b.
+ * @details The maximum error is 3 ULP. Signed zeros are handled as `atan2f` handles them.
  * @return A vector containing the two argument arc tangent of @p a and @p b.
  */
 static vec vec_atan2f(const vec a, const vec b) {
-	return vec4f(atan2f(vec_x(a), vec_x(b)),
-				 atan2f(vec_y(a), vec_y(b)),
-				 atan2f(vec_z(a), vec_z(b)),
-				 atan2f(vec_w(a), vec_w(b)));
+
+	const vec sign_a = _mm_and_ps(a, vec_new(-0.f));
+	const vec sign_b = _mm_and_ps(b, vec_new(-0.f));
+
+	const vec abs_a = _mm_xor_ps(a, sign_a);
+	const vec abs_b = _mm_xor_ps(b, sign_b);
+
+	// reduce to atan(min / max) in the first octant, and then by π/4 if min / max > tan(π/8)
+	const vec min = vec_min(abs_a, abs_b);
+	const vec max = vec_max(abs_a, abs_b);
+
+	const vec mid = _mm_cmpgt_ps(min, vec_multiply(max, vec_new(0.4142135623730950f)));
+
+	const vec n = _mm_blendv_ps(min, vec_subtract(min, max), mid);
+	vec d = _mm_blendv_ps(max, vec_add(min, max), mid);
+	d = _mm_blendv_ps(d, vec_new(1.f), _mm_cmpeq_ps(d, vec0()));
+
+	vec r = vec_add(_mm_and_ps(mid, vec_new(M_PI_4)), vec_trig_atan(vec_divide(n, d)));
+
+	// unfold the octant and quadrant by the magnitudes and signs of a and b
+	r = _mm_blendv_ps(r, vec_subtract(vec_new(M_PI_2), r), _mm_cmpgt_ps(abs_a, abs_b));
+	r = _mm_blendv_ps(r, vec_subtract(vec_new(M_PI), r), sign_b);
+
+	return _mm_xor_ps(r, sign_a);
 }
 
 /**
@@ -341,6 +862,72 @@ static ivec vec_compare_ne(const vec a, const vec b) {
 	return ivec_cast_vec(_mm_cmpneq_ps(a, b));
 }
 
+/**
+ * @brief Converts four half precision values to single precision, exactly.
+ * @details F16C is used when available, and is bit exact with vec_convert_half_soft.
+ * @param h The four half precision values in the low 64 bits.
+ */
+static vec vec_convert_half(const ivec h) {
+#if defined(__F16C__)
+	return _mm_cvtph_ps(h);
+#else
+	return vec_convert_half_soft(h);
+#endif
+}
+
+/**
+ * @brief Converts @p count half precision values to floats.
+ * @details Runs eight at a time with F16C where it is supported.
+ * @param out The output array, which need not be aligned.
+ * @param in The input array, which need not be aligned.
+ */
+static void vec_convert_half_array(float *out, const half *in, size_t count) {
+
+#if QUEMATH_F16C
+	if (count >= 8 && cpu_has_f16c()) {
+		vec_convert_half_array_f16c(out, in, count);
+		return;
+	}
+#endif
+
+	vec_convert_half_array_sse(out, in, count);
+}
+
+/**
+ * @brief Converts @p count half precision values to floats, four at a time.
+ * @see vec_convert_half_array
+ */
+static void vec_convert_half_array_sse(float *out, const half *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_ps(out + i, vec_convert_half(_mm_loadl_epi64((const __m128i *) (in + i))));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_x(vec_convert_half(ivec1i(in[i])));
+	}
+}
+
+/**
+ * @brief Converts four half precision values to single precision without F16C.
+ * @details Subnormals are normalized by multiplying by `2^112`, and NaN is quieted with its payload
+ * preserved, as by F16C.
+ * @param h The four half precision values in the low 64 bits.
+ */
+static vec vec_convert_half_soft(const ivec h) {
+
+	const ivec x = _mm_cvtepu16_epi32(h);
+	const ivec magnitude = _mm_and_si128(x, ivec_new(0x7fff));
+	const ivec sign = _mm_slli_epi32(_mm_xor_si128(x, magnitude), 16);
+
+	const vec magic = vec_cast_ivec(ivec_new((254 - 15) << 23));
+	const vec scaled = vec_multiply(vec_cast_ivec(_mm_slli_epi32(magnitude, 13)), magic);
+
+	const ivec infnan = _mm_and_si128(_mm_cmpgt_epi32(magnitude, ivec_new(0x7bff)), ivec_new(0x7f800000));
+	const ivec nan = _mm_and_si128(_mm_cmpgt_epi32(magnitude, ivec_new(0x7c00)), ivec_new(0x400000));
+
+	return vec_cast_ivec(_mm_or_si128(_mm_or_si128(ivec_cast_vec(scaled), sign), _mm_or_si128(infnan, nan)));
+}
+
 /**
  * @brief Converts the integer vector @p v to its floating point representation.
  * @return A vector containing the single precision floating point representation of @p v.
@@ -349,12 +936,63 @@ static vec vec_convert_ivec(const ivec v) {
 	return _mm_cvtepi32_ps(v);
 }
 
+/**
+ * @brief Decodes the octahedral vector @p o, at 8 bits per component.
+ * @return The unit vector.
+ */
+static vec vec_convert_oct16(const oct16 o) {
+	const vec3x4 n = vec3x4_convert_oct16(ivec1i(o));
+	return _mm_movelh_ps(_mm_unpacklo_ps(n.x, n.y), _mm_unpacklo_ps(n.z, vec0()));
+}
+
+/**
+ * @brief Decodes the octahedral vector @p o, at 16 bits per component.
+ * @return The unit vector.
+ */
+static vec vec_convert_oct32(const oct32 o) {
+	const vec3x4 n = vec3x4_convert_oct32(ivec1i((int) o));
+	return _mm_movelh_ps(_mm_unpacklo_ps(n.x, n.y), _mm_unpacklo_ps(n.z, vec0()));
+}
+
+/**
+ * @brief Decodes the four 8 bit signed normalized components of @p s.
+ * @return The vector, in `[-1, 1]`.
+ */
+static vec vec_convert_snorm32(const snorm32 s) {
+	const vec v = vec_convert_ivec(_mm_cvtepi8_epi32(ivec1i((int) s)));
+	return vec_max(vec_scale(v, 1.f / 127), vec_new(-1));
+}
+
+/**
+ * @brief Decodes the four 16 bit signed normalized components of @p s.
+ * @return The vector, in `[-1, 1]`.
+ */
+static vec vec_convert_snorm64(const snorm64 s) {
+	const vec v = vec_convert_ivec(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *) s.v)));
+	return vec_max(vec_scale(v, 1.f / 32767), vec_new(-1));
+}
+
 /**
  * @brief Calculates the cosine of @p v.
+ * @details The maximum error is 1 ULP for `|v| <= π/4` and 14 ULP for `|v| <= 2π`. The absolute
+ * error is below `1e-7` for `|v| <= 8192`, beyond which precision degrades.
  * @return A vector containing the cosine of @p v.
  */
 static vec vec_cosf(const vec v) {
-	return vec4f(cosf(vec_x(v)), cosf(vec_y(v)), cosf(vec_z(v)), cosf(vec_w(v)));
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	return vec_trig_select(ivec_add(quadrant, ivec_new(1)), vec_trig_sin(r), vec_trig_cos(r));
+}
+
+/**
+ * @brief Calculates the approximate cosine of @p v.
+ * @details The maximum absolute error is `1.4e-5` for `|v| <= 8192`.
+ * @return A vector containing the approximate cosine of @p v.
+ */
+static vec vec_cosf_fast(const vec v) {
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	return vec_trig_select(ivec_add(quadrant, ivec_new(1)), vec_trig_sin_fast(r), vec_trig_cos_fast(r));
 }
 
 /**
@@ -363,10 +1001,7 @@ static vec vec_cosf(const vec v) {
  */
 static vec vec_cross(const vec a, const vec b) {
 	// https://www.mathsisfun.com/algebra/vectors-cross-product.html
-	return vec_subtract(
-		vec_multiply(vec_yzx(a), vec_zxy(b)),
-		vec_multiply(vec_zxy(a), vec_yzx(b))
-	);
+	return vec_multiply_subtract(vec_yzx(a), vec_zxy(b), vec_multiply(vec_zxy(a), vec_yzx(b)));
 }
 
 /**
@@ -393,28 +1028,97 @@ static vec vec_divide(const vec a, const vec b) {
 	return _mm_div_ps(a, b);
 }
 
+/**
+ * @brief Calculates the approximate quotient of @p a `÷` @p b, by the reciprocal of @p b.
+ * @return A vector containing the product of @p a `*` vec_rcp(b).
+ * @see QUEMATH_PRECISION
+ */
+static vec vec_divide_fast(const vec a, const vec b) {
+	return vec_multiply(a, vec_rcp(b));
+}
+
 /**
  * @brief Calculates the two-component dot product of @p a `·` @p b.
- * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p `·` @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p a `·` @p b.
  */
 static vec vec_dot2(const vec a, const vec b) {
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
 	return _mm_dp_ps(a, b, 0x31);
+#else
+	return _mm_blend_ps(vec0(), vec_horizontal_add(_mm_blend_ps(vec_multiply(a, b), vec0(), 0xC)), 0x1);
+#endif
 }
 
 /**
  * @brief Calculates the three-component dot product of @p a `·` @p b.
- * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p `·` @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p a `·` @p b.
  */
 static vec vec_dot3(const vec a, const vec b) {
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
 	return _mm_dp_ps(a, b, 0x71);
+#else
+	return _mm_blend_ps(vec0(), vec_dot3_broadcast(a, b), 0x1);
+#endif
+}
+
+/**
+ * @brief Calculates the three-component dot product of @p a `·` @p b, in all four components.
+ * @return A vector `(d, d, d, d)`, where `d` is the dot product of @p a `·` @p b.
+ */
+static vec vec_dot3_broadcast(const vec a, const vec b) {
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
+	return _mm_dp_ps(a, b, 0x7F);
+#else
+	return vec_horizontal_add(_mm_blend_ps(vec_multiply(a, b), vec0(), 0x8));
+#endif
+}
+
+/**
+ * @brief Calculates four independent three-component dot products, of @p a `·` @p b.
+ * @details The four products are transposed, so that the sums need no horizontal reduction.
+ * This is cheaper than four calls to vec_dot3, and leaves the results in a single register.
+ * @return A vector `(d0, d1, d2, d3)`, where `dn` is the dot product of `a[n]` `·` `b[n]`.
+ */
+static vec vec_dot3x4(const vec a[4], const vec b[4]) {
+	const vec p0 = vec_multiply(a[0], b[0]);
+	const vec p1 = vec_multiply(a[1], b[1]);
+	const vec p2 = vec_multiply(a[2], b[2]);
+	const vec p3 = vec_multiply(a[3], b[3]);
+
+	const vec xy01 = _mm_unpacklo_ps(p0, p1);
+	const vec xy23 = _mm_unpacklo_ps(p2, p3);
+	const vec zw01 = _mm_unpackhi_ps(p0, p1);
+	const vec zw23 = _mm_unpackhi_ps(p2, p3);
+
+	const vec x = _mm_movelh_ps(xy01, xy23);
+	const vec y = _mm_movehl_ps(xy23, xy01);
+	const vec z = _mm_movelh_ps(zw01, zw23);
+
+	return vec_add(vec_add(x, y), z);
 }
 
 /**
  * @brief Calculates the four-component dot product of @p a `·` @p b.
- * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p `·` @p b.
+ * @return A vector `(d, 0, 0, 0)`, where `d` is the dot product of @p a `·` @p b.
  */
 static vec vec_dot4(const vec a, const vec b) {
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
 	return _mm_dp_ps(a, b, 0xF1);
+#else
+	return _mm_blend_ps(vec0(), vec_dot4_broadcast(a, b), 0x1);
+#endif
+}
+
+/**
+ * @brief Calculates the four-component dot product of @p a `·` @p b, in all four components.
+ * @return A vector `(d, d, d, d)`, where `d` is the dot product of @p a `·` @p b.
+ */
+static vec vec_dot4_broadcast(const vec a, const vec b) {
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
+	return _mm_dp_ps(a, b, 0xFF);
+#else
+	return vec_horizontal_add(vec_multiply(a, b));
+#endif
 }
 
 /**
@@ -441,6 +1145,15 @@ static int vec_greater_than_equal(const vec a, const vec b) {
 	return _mm_testc_si128(vec_compare_ge(a, b), ivec_true());
 }
 
+/**
+ * @brief Calculates the sum of the four components of @p v, in all four components.
+ * @return A vector `(s, s, s, s)`, where `s` is the sum of the components of @p v.
+ */
+static vec vec_horizontal_add(const vec v) {
+	const vec t = vec_add(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	return vec_add(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
 /**
  * @brief Calculates the length, or magnitude, of the vector @p v.
  * @return A vector `(l, 0, 0, 0)`, where `l` is the length of the vector @p v.
@@ -486,7 +1199,7 @@ static vec vec_min(const vec a, const vec b) {
  * @return A vector equal to `a * (1 - mix) + b * mix`.
  */
 static vec vec_mix(const vec a, const vec b, float mix) {
-	return vec_add(vec_scale(a, 1 - mix), vec_scale(b, mix));
+	return vec_multiply_add(b, vec_new(mix), vec_scale(a, 1 - mix));
 }
 
 /**
@@ -497,6 +1210,32 @@ static vec vec_multiply(const vec a, const vec b) {
 	return _mm_mul_ps(a, b);
 }
 
+/**
+ * @brief Calculates the sum of the product @p a `*` @p b and @p c.
+ * @details Where QUEMATH_HAS_FMA is set, the product is not rounded before the sum.
+ * @return A vector containing @p a `*` @p b `+` @p c.
+ */
+static vec vec_multiply_add(const vec a, const vec b, const vec c) {
+#if QUEMATH_HAS_FMA
+	return _mm_fmadd_ps(a, b, c);
+#else
+	return vec_add(vec_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Calculates the difference of the product @p a `*` @p b and @p c.
+ * @details Where QUEMATH_HAS_FMA is set, the product is not rounded before the difference.
+ * @return A vector containing @p a `*` @p b `-` @p c.
+ */
+static vec vec_multiply_subtract(const vec a, const vec b, const vec c) {
+#if QUEMATH_HAS_FMA
+	return _mm_fmsub_ps(a, b, c);
+#else
+	return vec_subtract(vec_multiply(a, b), c);
+#endif
+}
+
 /**
  * @brief Returns the negated value of @p v.
  * @return A vector equal to the negated value of @p v.
@@ -518,15 +1257,16 @@ static vec vec_new(float f) {
  * @return A unit vector in the same direction of @p v.
  */
 static vec vec_normalize(const vec v) {
-	return vec_divide(v, vec_sqrt(_mm_dp_ps(v, v, 0x7F)));
+	return vec_divide(v, vec_sqrt(vec_dot3_broadcast(v, v)));
 }
 
 /**
  * @brief Calculates the approximate unit length vector of @p v by the inverse square root.
  * @return A unit vector approximation in the same direction of @p v.
+ * @see QUEMATH_PRECISION
  */
 static vec vec_normalize_fast(const vec v) {
-	return vec_multiply(v, vec_rsqrt(_mm_dp_ps(v, v, 0x7F)));
+	return vec_multiply(v, vec_rsqrt(vec_dot3_broadcast(v, v)));
 }
 
 /**
@@ -566,59 +1306,329 @@ static vec vec_random_range(vec last, const vec mins, const vec maxs) {
 }
 
 /**
- * @brief Calculates the approximate inverse square root of @p v.
- * @return A vector containing the approximate inverse square root of @p v.
+ * @brief Calculates the approximate reciprocal of @p v, at the precision tier of the build.
+ * @return A vector containing the approximate reciprocal of @p v.
+ * @see QUEMATH_PRECISION
  */
-static vec vec_rsqrt(const vec v) {
-	return _mm_rsqrt_ps(v);
+static vec vec_rcp(const vec v) {
+#if QUEMATH_PRECISION == QUEMATH_PRECISION_ESTIMATE
+	return vec_rcp_estimate(v);
+#elif QUEMATH_PRECISION == QUEMATH_PRECISION_REFINED
+	return vec_rcp_refined(v);
+#else
+	return vec_rcp_precise(v);
+#endif
 }
 
 /**
- * @brief Calculates the scalar product of @p v `*` @p scale.
- * @return A vector containing the scalar product @p v `*` @p scale.
+ * @brief Estimates the reciprocal of @p v, with a relative error of at most `1.5 * 2^-12`.
+ * @return A vector containing the estimated reciprocal of @p v.
  */
-static vec vec_scale(const vec v, float scale) {
-	return vec_multiply(v, vec_new(scale));
+static vec vec_rcp_estimate(const vec v) {
+	return _mm_rcp_ps(v);
 }
 
 /**
- * @brief Calculates the sum of @p a and the scalar product @p b `*` @p scale.
- * @return A vector containing the sum of @p a and the scalar product @p b `*` @p scale.
+ * @brief Calculates the reciprocal of @p v by division, correctly rounded.
+ * @return A vector containing the reciprocal of @p v.
  */
-static vec vec_scale_add(const vec a, const vec b, float scale) {
-	return vec_add(a, vec_scale(b, scale));
+static vec vec_rcp_precise(const vec v) {
+	return vec_divide(vec_new(1), v);
 }
 
 /**
- * @brief Calculates the sine of @p v.
- * @return A vector containing the sine of @p v.
+ * @brief Calculates the reciprocal of @p v, refining the estimate with one Newton-Raphson step.
+ * @details The error is within three ULP. Zero and infinite @p v yield NaN.
+ * @return A vector containing the reciprocal of @p v.
  */
-static vec vec_sinf(const vec v) {
-	return vec4f(sinf(vec_x(v)), sinf(vec_y(v)), sinf(vec_z(v)), sinf(vec_w(v)));
+static vec vec_rcp_refined(const vec v) {
+	const vec r = vec_rcp_estimate(v);
+
+	// r' = r + r * (1 - v * r)
+	const vec e = vec_multiply_add(vec_negate(v), r, vec_new(1));
+	return vec_multiply_add(r, e, r);
 }
 
 /**
- * @brief Calculates the square root of @p v.
- * @return A vector containing the square root of @p v.
+ * @brief Calculates the approximate inverse square root of @p v, at the precision tier of the build.
+ * @return A vector containing the approximate inverse square root of @p v.
+ * @see QUEMATH_PRECISION
  */
-static vec vec_sqrt(const vec v) {
-	return _mm_sqrt_ps(v);
+static vec vec_rsqrt(const vec v) {
+#if QUEMATH_PRECISION == QUEMATH_PRECISION_ESTIMATE
+	return vec_rsqrt_estimate(v);
+#elif QUEMATH_PRECISION == QUEMATH_PRECISION_REFINED
+	return vec_rsqrt_refined(v);
+#else
+	return vec_rsqrt_precise(v);
+#endif
 }
 
 /**
- * @brief Calculates the difference of @p a `-` @p b.
- * @return A vector containing the difference of @p a `-` @p b.
+ * @brief Estimates the inverse square root of @p v, with a relative error of at most `1.5 * 2^-12`.
+ * @return A vector containing the estimated inverse square root of @p v.
  */
-static vec vec_subtract(const vec a, const vec b) {
-	return _mm_sub_ps(a, b);
+static vec vec_rsqrt_estimate(const vec v) {
+	return _mm_rsqrt_ps(v);
+}
+
+/**
+ * @brief Calculates the inverse square root of @p v by square root and division, to within 1.5 ULP.
+ * @return A vector containing the inverse square root of @p v.
+ */
+static vec vec_rsqrt_precise(const vec v) {
+	return vec_divide(vec_new(1), vec_sqrt(v));
+}
+
+/**
+ * @brief Calculates the inverse square root of @p v, refining the estimate with one Newton-Raphson step.
+ * @details The error is within four ULP. Zero and infinite @p v yield NaN.
+ * @return A vector containing the inverse square root of @p v.
+ */
+static vec vec_rsqrt_refined(const vec v) {
+	const vec r = vec_rsqrt_estimate(v);
+
+	// r' = r + r * (0.5 - 0.5 * v * r * r)
+	const vec e = vec_multiply_add(vec_scale(v, -0.5), vec_multiply(r, r), vec_new(0.5));
+	return vec_multiply_add(r, e, r);
+}
+
+/**
+ * @brief Calculates the scalar product of @p v `*` @p scale.
+ * @return A vector containing the scalar product @p v `*` @p scale.
+ */
+static vec vec_scale(const vec v, float scale) {
+	return vec_multiply(v, vec_new(scale));
+}
+
+/**
+ * @brief Calculates the sum of @p a and the scalar product @p b `*` @p scale.
+ * @return A vector containing the sum of @p a and the scalar product @p b `*` @p scale.
+ */
+static vec vec_scale_add(const vec a, const vec b, float scale) {
+	return vec_multiply_add(b, vec_new(scale), a);
+}
+
+/**
+ * @brief Calculates the sine and cosine of @p v, sharing a single range reduction.
+ * @details The results are identical to those of vec_sinf and vec_cosf.
+ * @param s The output for the sine of @p v.
+ * @param c The output for the cosine of @p v.
+ */
+static void vec_sincosf(const vec v, vec *s, vec *c) {
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	const vec sin_r = vec_trig_sin(r), cos_r = vec_trig_cos(r);
+	*s = vec_trig_select(quadrant, sin_r, cos_r);
+	*c = vec_trig_select(ivec_add(quadrant, ivec_new(1)), sin_r, cos_r);
+}
+
+/**
+ * @brief Calculates the sines and cosines of @p count angles.
+ * @param s The output array for the sines of @p v, which may alias @p v.
+ * @param c The output array for the cosines of @p v, which may alias @p v.
+ */
+static void vec_sincosf_array(float *s, float *c, const float *v, size_t count) {
+	vec sv, cv;
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec_sincosf(_mm_loadu_ps(v + i), &sv, &cv);
+		_mm_storeu_ps(s + i, sv);
+		_mm_storeu_ps(c + i, cv);
+	}
+	for (size_t i = batch; i < count; i++) {
+		vec_sincosf(vec1f(v[i]), &sv, &cv);
+		s[i] = vec_x(sv);
+		c[i] = vec_x(cv);
+	}
+}
+
+/**
+ * @brief Calculates the sine of @p v.
+ * @details The maximum error is 1 ULP for `|v| <= 2π`. The absolute error is below `1e-7` for
+ * `|v| <= 8192`, beyond which precision degrades.
+ * @return A vector containing the sine of @p v.
+ */
+static vec vec_sinf(const vec v) {
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	return vec_trig_select(quadrant, vec_trig_sin(r), vec_trig_cos(r));
+}
+
+/**
+ * @brief Calculates the approximate sine of @p v.
+ * @details The maximum absolute error is `1.4e-5` for `|v| <= 8192`.
+ * @return A vector containing the approximate sine of @p v.
+ */
+static vec vec_sinf_fast(const vec v) {
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	return vec_trig_select(quadrant, vec_trig_sin_fast(r), vec_trig_cos_fast(r));
+}
+
+/**
+ * @brief Calculates the square root of @p v.
+ * @return A vector containing the square root of @p v.
+ */
+static vec vec_sqrt(const vec v) {
+	return _mm_sqrt_ps(v);
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ * @return A vector containing the difference of @p a `-` @p b.
+ */
+static vec vec_subtract(const vec a, const vec b) {
+	return _mm_sub_ps(a, b);
 }
 
 /**
  * @brief Calculates the tangent of @p v.
+ * @details The maximum error is 2 ULP for `|v| <= π/4` and 11 ULP for `|v| <= 2π`.
  * @return A vector containing the tangent of @p v.
  */
 static vec vec_tanf(const vec v) {
-	return vec4f(tanf(vec_x(v)), tanf(vec_y(v)), tanf(vec_z(v)), tanf(vec_w(v)));
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec t = vec_trig_tan(vec_trig_reduce(v, quadrant));
+	const ivec odd = ivec_compare_eq(_mm_and_si128(quadrant, ivec_new(1)), ivec_new(1));
+	return _mm_blendv_ps(t, vec_divide(vec_new(-1), t), vec_cast_ivec(odd));
+}
+
+/**
+ * @brief Calculates the approximate tangent of @p v.
+ * @details The maximum relative error is `1.4e-5` for `|v| <= 2π`.
+ * @return A vector containing the approximate tangent of @p v.
+ */
+static vec vec_tanf_fast(const vec v) {
+	const ivec quadrant = vec_trig_quadrant(v);
+	const vec r = vec_trig_reduce(v, quadrant);
+	const vec s = vec_trig_sin_fast(r), c = vec_trig_cos_fast(r);
+	const ivec odd = ivec_compare_eq(_mm_and_si128(quadrant, ivec_new(1)), ivec_new(1));
+	return vec_divide(_mm_blendv_ps(s, vec_negate(c), vec_cast_ivec(odd)),
+					  _mm_blendv_ps(c, s, vec_cast_ivec(odd)));
+}
+
+/**
+ * @brief Evaluates the arc sine of @p x in `[0, 1/2]` with a minimax polynomial.
+ * @return A vector containing the arc sine of @p x.
+ */
+static vec vec_trig_asin(const vec x) {
+	const vec z = vec_multiply(x, x);
+	vec p = vec_new(4.2163199048e-2f);
+	p = vec_add(vec_multiply(p, z), vec_new(2.4181311049e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(4.5470025998e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(7.4953002686e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(1.6666752422e-1f));
+	return vec_add(vec_multiply(vec_multiply(p, z), x), x);
+}
+
+/**
+ * @brief Evaluates the arc tangent of @p x in `[-tan(π/8), tan(π/8)]` with a minimax polynomial.
+ * @return A vector containing the arc tangent of @p x.
+ */
+static vec vec_trig_atan(const vec x) {
+	const vec z = vec_multiply(x, x);
+	vec p = vec_new(8.05374449538e-2f);
+	p = vec_add(vec_multiply(p, z), vec_new(-1.38776856032e-1f));
+	p = vec_add(vec_multiply(p, z), vec_new(1.99777106478e-1f));
+	p = vec_add(vec_multiply(p, z), vec_new(-3.33329491539e-1f));
+	return vec_add(vec_multiply(vec_multiply(p, z), x), x);
+}
+
+/**
+ * @brief Evaluates the cosine of @p r in `[-π/4, π/4]` with a minimax polynomial.
+ * @return A vector containing the cosine of @p r.
+ */
+static vec vec_trig_cos(const vec r) {
+	const vec z = vec_multiply(r, r);
+	vec p = vec_new(2.443315711809948e-5f);
+	p = vec_add(vec_multiply(p, z), vec_new(-1.388731625493765e-3f));
+	p = vec_add(vec_multiply(p, z), vec_new(4.166664568298827e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(-0.5f));
+	return vec_add(vec_multiply(p, z), vec_new(1.f));
+}
+
+/**
+ * @brief Evaluates the approximate cosine of @p r in `[-π/4, π/4]` with a minimax polynomial.
+ * @return A vector containing the approximate cosine of @p r.
+ */
+static vec vec_trig_cos_fast(const vec r) {
+	const vec z = vec_multiply(r, r);
+	vec p = vec_new(4.045845177e-2f);
+	p = vec_add(vec_multiply(p, z), vec_new(-4.997605568e-1f));
+	return vec_add(vec_multiply(p, z), vec_new(1.f));
+}
+
+/**
+ * @brief Calculates the nearest integer multiple of `π/2` to @p v.
+ * @return An integer vector containing the quadrant of each component of @p v.
+ */
+static ivec vec_trig_quadrant(const vec v) {
+	return ivec_convert_vec(vec_multiply(v, vec_new(2 / M_PI)));
+}
+
+/**
+ * @brief Reduces @p v to `[-π/4, π/4]` by subtracting @p quadrant multiples of `π/2`.
+ * @details `π/2` is split in three parts (Cody-Waite) so that the products with @p quadrant
+ * are exact for `|quadrant| < 2^16`.
+ * @return A vector containing the reduced angles of @p v.
+ */
+static vec vec_trig_reduce(const vec v, const ivec quadrant) {
+	const vec q = vec_convert_ivec(quadrant);
+	vec r = vec_subtract(v, vec_multiply(q, vec_new(1.5703125f)));
+	r = vec_subtract(r, vec_multiply(q, vec_new(4.837512969970703125e-4f)));
+	return vec_subtract(r, vec_multiply(q, vec_new(7.54978995489188216e-8f)));
+}
+
+/**
+ * @brief Selects the sine or cosine of the reduced angle by @p quadrant.
+ * @param quadrant The quadrant of the unreduced angle.
+ * @param s The sine of the reduced angle.
+ * @param c The cosine of the reduced angle.
+ * @return A vector containing the sine of the unreduced angle.
+ */
+static vec vec_trig_select(const ivec quadrant, const vec s, const vec c) {
+	const ivec odd = ivec_compare_eq(_mm_and_si128(quadrant, ivec_new(1)), ivec_new(1));
+	const ivec sign = _mm_slli_epi32(_mm_and_si128(quadrant, ivec_new(2)), 30);
+	return _mm_xor_ps(_mm_blendv_ps(s, c, vec_cast_ivec(odd)), vec_cast_ivec(sign));
+}
+
+/**
+ * @brief Evaluates the sine of @p r in `[-π/4, π/4]` with a minimax polynomial.
+ * @return A vector containing the sine of @p r.
+ */
+static vec vec_trig_sin(const vec r) {
+	const vec z = vec_multiply(r, r);
+	vec p = vec_new(-1.9515295891e-4f);
+	p = vec_add(vec_multiply(p, z), vec_new(8.3321608736e-3f));
+	p = vec_add(vec_multiply(p, z), vec_new(-1.6666654611e-1f));
+	return vec_add(vec_multiply(vec_multiply(p, z), r), r);
+}
+
+/**
+ * @brief Evaluates the approximate sine of @p r in `[-π/4, π/4]` with a minimax polynomial.
+ * @return A vector containing the approximate sine of @p r.
+ */
+static vec vec_trig_sin_fast(const vec r) {
+	const vec z = vec_multiply(r, r);
+	vec p = vec_new(8.163281851e-3f);
+	p = vec_add(vec_multiply(p, z), vec_new(-1.666339037e-1f));
+	return vec_add(vec_multiply(vec_multiply(p, z), r), r);
+}
+
+/**
+ * @brief Evaluates the tangent of @p r in `[-π/4, π/4]` with a minimax polynomial.
+ * @return A vector containing the tangent of @p r.
+ */
+static vec vec_trig_tan(const vec r) {
+	const vec z = vec_multiply(r, r);
+	vec p = vec_new(9.38540185543e-3f);
+	p = vec_add(vec_multiply(p, z), vec_new(3.11992232697e-3f));
+	p = vec_add(vec_multiply(p, z), vec_new(2.44301354525e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(5.34112807005e-2f));
+	p = vec_add(vec_multiply(p, z), vec_new(1.33387994085e-1f));
+	p = vec_add(vec_multiply(p, z), vec_new(3.33331568548e-1f));
+	return vec_add(vec_multiply(vec_multiply(p, z), r), r);
 }
 
 /**
@@ -668,7 +1678,7 @@ static float vec_x(const vec v) {
  * @return The swizzle `(x, y, z, 0)` of the vector @p v.
  */
 static vec vec_xyz(const vec v) {
-	return _mm_and_ps(v, ivec3i(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF));
+	return _mm_and_ps(v, vec_cast_ivec(ivec3i(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF)));
 }
 
 /**
@@ -703,6 +1713,616 @@ static vec vec_zxy(const vec v) {
 	return vec_xyz(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)));
 }
 
+/**
+ * @brief Converts @p count packed half precision two component vectors, four bytes each.
+ */
+static void vec2_convert_half_array(vec2 *out, const half *in, size_t count) {
+	vec_convert_half_array((float *) out, in, count * 2);
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b for @p count vectors.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ * @param out The output array, which may alias @p a or @p b.
+ */
+static void vec3_add_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_add_array_avx512(out, a, b, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_add_array_avx2(out, a, b, count);
+		return;
+	}
+#endif
+
+	vec3_add_array_sse(out, a, b, count);
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b for @p count vectors, four at a time.
+ * @see vec3_add_array
+ */
+static void vec3_add_array_sse(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_add(vec3x4_load(a + i), vec3x4_load(b + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_add(vec3fv(a[i]), vec3fv(b[i])));
+	}
+}
+
+/**
+ * @brief Converts @p count packed half precision three component vectors, six bytes each.
+ */
+static void vec3_convert_half_array(vec3 *out, const half *in, size_t count) {
+	vec_convert_half_array((float *) out, in, count * 3);
+}
+
+/**
+ * @brief Decodes @p count octahedral vectors at 8 bits per component, four at a time.
+ * @param in The input array, which need not be aligned.
+ */
+static void vec3_convert_oct16_array(vec3 *out, const oct16 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_convert_oct16(_mm_loadl_epi64((const __m128i *) (in + i))), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_convert_oct16(in[i]));
+	}
+}
+
+/**
+ * @brief Decodes @p count octahedral vectors at 16 bits per component, four at a time.
+ * @param in The input array, which need not be aligned.
+ */
+static void vec3_convert_oct32_array(vec3 *out, const oct32 *in, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_convert_oct32(_mm_loadu_si128((const __m128i *) (in + i))), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_convert_oct32(in[i]));
+	}
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b for @p count vectors.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ * @param out The output array, which may alias @p a or @p b.
+ */
+static void vec3_cross_array(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_cross_array_avx512(out, a, b, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_cross_array_avx2(out, a, b, count);
+		return;
+	}
+#endif
+
+	vec3_cross_array_sse(out, a, b, count);
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b for @p count vectors, four at a time.
+ * @see vec3_cross_array
+ */
+static void vec3_cross_array_sse(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_cross(vec3x4_load(a + i), vec3x4_load(b + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_cross(vec3fv(a[i]), vec3fv(b[i])));
+	}
+}
+
+/**
+ * @brief Calculates the distances between the points @p a and @p b for @p count points.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ */
+static void vec3_distance_array(float *out, const vec3 *a, const vec3 *b, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_distance_array_avx512(out, a, b, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_distance_array_avx2(out, a, b, count);
+		return;
+	}
+#endif
+
+	vec3_distance_array_sse(out, a, b, count);
+}
+
+/**
+ * @brief Calculates the distances between the points @p a and @p b for @p count points, four at a time.
+ * @see vec3_distance_array
+ */
+static void vec3_distance_array_sse(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_ps(out + i, vec3x4_distance(vec3x4_load(a + i), vec3x4_load(b + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_x(vec_distance(vec3fv(a[i]), vec3fv(b[i])));
+	}
+}
+
+/**
+ * @brief Calculates the three-component dot products of @p a `·` @p b for @p count vectors.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ */
+static void vec3_dot3_array(float *out, const vec3 *a, const vec3 *b, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_dot3_array_avx512(out, a, b, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_dot3_array_avx2(out, a, b, count);
+		return;
+	}
+#endif
+
+	vec3_dot3_array_sse(out, a, b, count);
+}
+
+/**
+ * @brief Calculates the three-component dot products of @p a `·` @p b for @p count vectors, four at a time.
+ * @see vec3_dot3_array
+ */
+static void vec3_dot3_array_sse(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_ps(out + i, vec3x4_dot3(vec3x4_load(a + i), vec3x4_load(b + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_x(vec_dot3(vec3fv(a[i]), vec3fv(b[i])));
+	}
+}
+
+/**
+ * @brief Calculates the lengths of @p count vectors.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ */
+static void vec3_length_array(float *out, const vec3 *v, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_length_array_avx512(out, v, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_length_array_avx2(out, v, count);
+		return;
+	}
+#endif
+
+	vec3_length_array_sse(out, v, count);
+}
+
+/**
+ * @brief Calculates the lengths of @p count vectors, four at a time.
+ * @see vec3_length_array
+ */
+static void vec3_length_array_sse(float *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		_mm_storeu_ps(out + i, vec3x4_length(vec3x4_load(v + i)));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_x(vec_length(vec3fv(v[i])));
+	}
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p count vectors by the square root.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ * @param out The output array, which may alias @p v.
+ */
+static void vec3_normalize_array(vec3 *out, const vec3 *v, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_normalize_array_avx512(out, v, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_normalize_array_avx2(out, v, count);
+		return;
+	}
+#endif
+
+	vec3_normalize_array_sse(out, v, count);
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p count vectors by the square root, four at a time.
+ * @see vec3_normalize_array
+ */
+static void vec3_normalize_array_sse(vec3 *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_normalize(vec3x4_load(v + i)), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_normalize(vec3fv(v[i])));
+	}
+}
+
+/**
+ * @brief Calculates the sums of @p a and the scalar products @p b `*` @p scale for @p count vectors.
+ * @details Runs eight or sixteen at a time where AVX2 or AVX-512 is supported.
+ * @param out The output array, which may alias @p a or @p b.
+ */
+static void vec3_scale_add_array(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) {
+
+#if QUEMATH_AVX512
+	if (count >= 16 && cpu_has_avx512()) {
+		vec3_scale_add_array_avx512(out, a, b, scale, count);
+		return;
+	}
+#endif
+#if QUEMATH_AVX2
+	if (count >= 8 && cpu_has_avx2()) {
+		vec3_scale_add_array_avx2(out, a, b, scale, count);
+		return;
+	}
+#endif
+
+	vec3_scale_add_array_sse(out, a, b, scale, count);
+}
+
+/**
+ * @brief Calculates the sums of @p a and the scalar products @p b `*` @p scale for @p count vectors, four at a time.
+ * @see vec3_scale_add_array
+ */
+static void vec3_scale_add_array_sse(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) {
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		vec3x4_store(vec3x4_scale_add(vec3x4_load(a + i), vec3x4_load(b + i), scale), out + i);
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec3(vec_scale_add(vec3fv(a[i]), vec3fv(b[i]), scale));
+	}
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b.
+ * @return The four sums of @p a `+` @p b.
+ */
+static vec3x4 vec3x4_add(const vec3x4 a, const vec3x4 b) {
+	return (vec3x4) {
+		vec_add(a.x, b.x),
+		vec_add(a.y, b.y),
+		vec_add(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Decodes four octahedral vectors at 8 bits per component.
+ * @param o The four encoded vectors in the low 64 bits.
+ */
+static vec3x4 vec3x4_convert_oct16(const ivec o) {
+
+	const ivec i = _mm_cvtepu16_epi32(o);
+
+	const vec u = vec_convert_ivec(_mm_srai_epi32(_mm_slli_epi32(i, 24), 24));
+	const vec v = vec_convert_ivec(_mm_srai_epi32(_mm_slli_epi32(i, 16), 24));
+
+	const vec scale = vec_new(1.f / 127), minus_one = vec_new(-1);
+
+	return vec3x4_oct_decode(vec_max(vec_multiply(u, scale), minus_one), vec_max(vec_multiply(v, scale), minus_one));
+}
+
+/**
+ * @brief Decodes four octahedral vectors at 16 bits per component.
+ * @param o The four encoded vectors.
+ */
+static vec3x4 vec3x4_convert_oct32(const ivec o) {
+
+	const vec u = vec_convert_ivec(_mm_srai_epi32(_mm_slli_epi32(o, 16), 16));
+	const vec v = vec_convert_ivec(_mm_srai_epi32(o, 16));
+
+	const vec scale = vec_new(1.f / 32767), minus_one = vec_new(-1);
+
+	return vec3x4_oct_decode(vec_max(vec_multiply(u, scale), minus_one), vec_max(vec_multiply(v, scale), minus_one));
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b.
+ * @return The four cross products of @p a `×` @p b.
+ */
+static vec3x4 vec3x4_cross(const vec3x4 a, const vec3x4 b) {
+	return (vec3x4) {
+		vec_multiply_subtract(a.y, b.z, vec_multiply(a.z, b.y)),
+		vec_multiply_subtract(a.z, b.x, vec_multiply(a.x, b.z)),
+		vec_multiply_subtract(a.x, b.y, vec_multiply(a.y, b.x))
+	};
+}
+
+/**
+ * @brief Calculates the distances between the points @p a and @p b.
+ * @return A vector containing the four distances between points @p a and @p b.
+ */
+static vec vec3x4_distance(const vec3x4 a, const vec3x4 b) {
+	return vec3x4_length(vec3x4_subtract(b, a));
+}
+
+/**
+ * @brief Calculates the three-component dot products of @p a `·` @p b.
+ * @return A vector containing the four dot products of @p a `·` @p b.
+ */
+static vec vec3x4_dot3(const vec3x4 a, const vec3x4 b) {
+	return vec_multiply_add(a.z, b.z, vec_multiply_add(a.y, b.y, vec_multiply(a.x, b.x)));
+}
+
+/**
+ * @brief Calculates the lengths, or magnitudes, of the vectors @p v.
+ * @return A vector containing the four lengths of the vectors @p v.
+ */
+static vec vec3x4_length(const vec3x4 v) {
+	return vec_sqrt(vec3x4_dot3(v, v));
+}
+
+/**
+ * @brief Loads and transposes four packed three component vectors.
+ * @param v An array of at least four three component vectors.
+ * @return The vectors @p v in structure of arrays form.
+ */
+static vec3x4 vec3x4_load(const vec3 *v) {
+
+	const float *f = (const float *) v;
+
+	const vec a = _mm_loadu_ps(f + 0); // x0 y0 z0 x1
+	const vec b = _mm_loadu_ps(f + 4); // y1 z1 x2 y2
+	const vec c = _mm_loadu_ps(f + 8); // z2 x3 y3 z3
+
+	const vec b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+	const vec a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+	const vec b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+	const vec a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+
+	return (vec3x4) {
+		_mm_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0)),
+		_mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm_shuffle_ps(a2b1, c, _MM_SHUFFLE(3, 0, 2, 0))
+	};
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p v by the square root.
+ * @return Four unit vectors in the same directions of @p v.
+ */
+static vec3x4 vec3x4_normalize(const vec3x4 v) {
+
+	const vec length = vec3x4_length(v);
+
+	return (vec3x4) {
+		vec_divide(v.x, length),
+		vec_divide(v.y, length),
+		vec_divide(v.z, length)
+	};
+}
+
+/**
+ * @brief Decodes four vectors from octahedral coordinates @p u and @p v in `[-1, 1]`.
+ * @return The four unit vectors.
+ */
+static vec3x4 vec3x4_oct_decode(const vec u, const vec v) {
+
+	const vec abs = vec_new(-0.f);
+
+	const vec z = vec_subtract(vec_subtract(vec_new(1), _mm_andnot_ps(abs, u)), _mm_andnot_ps(abs, v));
+
+	// the lower hemisphere is folded over the diagonals, so unfold it toward the axes
+	const vec t = vec_max(vec_negate(z), vec0());
+
+	return vec3x4_normalize((vec3x4) {
+		vec_subtract(u, _mm_or_ps(t, _mm_and_ps(u, abs))),
+		vec_subtract(v, _mm_or_ps(t, _mm_and_ps(v, abs))),
+		z
+	});
+}
+
+/**
+ * @brief Encodes four unit vectors to octahedral coordinates.
+ * @details The vectors are projected onto the octahedron `|x| + |y| + |z| = 1`, and the lower
+ * hemisphere is folded over the diagonals of the upper.
+ * @param u The first octahedral coordinates, in `[-1, 1]`.
+ * @param v The second octahedral coordinates, in `[-1, 1]`.
+ */
+static void vec3x4_oct_encode(const vec3x4 n, vec *u, vec *v) {
+
+	const vec abs = vec_new(-0.f);
+
+	const vec ax = _mm_andnot_ps(abs, n.x);
+	const vec ay = _mm_andnot_ps(abs, n.y);
+	const vec az = _mm_andnot_ps(abs, n.z);
+
+	const vec scale = vec_divide(vec_new(1), vec_add(vec_add(ax, ay), az));
+
+	const vec x = vec_multiply(n.x, scale);
+	const vec y = vec_multiply(n.y, scale);
+
+	const vec one = vec_new(1);
+
+	const vec fx = _mm_or_ps(vec_subtract(one, _mm_andnot_ps(abs, y)), _mm_and_ps(x, abs));
+	const vec fy = _mm_or_ps(vec_subtract(one, _mm_andnot_ps(abs, x)), _mm_and_ps(y, abs));
+
+	const vec lower = _mm_cmplt_ps(n.z, vec0());
+
+	*u = _mm_blendv_ps(x, fx, lower);
+	*v = _mm_blendv_ps(y, fy, lower);
+}
+
+/**
+ * @brief Calculates the scalar products of @p v `*` @p scale.
+ * @return The four scalar products of @p v `*` @p scale.
+ */
+static vec3x4 vec3x4_scale(const vec3x4 v, float scale) {
+
+	const vec s = vec_new(scale);
+
+	return (vec3x4) {
+		vec_multiply(v.x, s),
+		vec_multiply(v.y, s),
+		vec_multiply(v.z, s)
+	};
+}
+
+/**
+ * @brief Calculates the sums of @p a and the scalar products @p b `*` @p scale.
+ * @return The four sums of @p a and the scalar products @p b `*` @p scale.
+ */
+static vec3x4 vec3x4_scale_add(const vec3x4 a, const vec3x4 b, float scale) {
+	const vec s = vec_new(scale);
+	return (vec3x4) {
+		vec_multiply_add(b.x, s, a.x),
+		vec_multiply_add(b.y, s, a.y),
+		vec_multiply_add(b.z, s, a.z)
+	};
+}
+
+/**
+ * @brief Transposes and stores four vectors as packed three component vectors.
+ * @param out An array of at least four three component vectors.
+ */
+static void vec3x4_store(const vec3x4 v, vec3 *out) {
+
+	const vec x0y0 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(0, 0, 0, 0));
+	const vec z0x1 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(1, 1, 0, 0));
+	const vec y1z1 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(1, 1, 1, 1));
+	const vec x2y2 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(2, 2, 2, 2));
+	const vec z2x3 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(3, 3, 2, 2));
+	const vec y3z3 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(3, 3, 3, 3));
+
+	float *f = (float *) out;
+
+	_mm_storeu_ps(f + 0, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(f + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(f + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ * @brief Calculates the differences of @p a `-` @p b.
+ * @return The four differences of @p a `-` @p b.
+ */
+static vec3x4 vec3x4_subtract(const vec3x4 a, const vec3x4 b) {
+	return (vec3x4) {
+		vec_subtract(a.x, b.x),
+		vec_subtract(a.y, b.y),
+		vec_subtract(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Converts @p count packed half precision four component vectors, eight bytes each.
+ */
+static void vec4_convert_half_array(vec4 *out, const half *in, size_t count) {
+	vec_convert_half_array((float *) out, in, count * 4);
+}
+
+/**
+ * @brief Decodes @p count vectors of four 8 bit signed normalized components, four at a time.
+ * @param in The input array, which need not be aligned.
+ */
+static void vec4_convert_snorm32_array(vec4 *out, const snorm32 *in, size_t count) {
+
+	const vec scale = vec_new(1.f / 127), minus_one = vec_new(-1);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec s = _mm_loadu_si128((const __m128i *) (in + i));
+
+		_mm_storeu_ps(out[i + 0].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi8_epi32(s)), scale), minus_one));
+		_mm_storeu_ps(out[i + 1].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi8_epi32(_mm_srli_si128(s, 4))), scale), minus_one));
+		_mm_storeu_ps(out[i + 2].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi8_epi32(_mm_srli_si128(s, 8))), scale), minus_one));
+		_mm_storeu_ps(out[i + 3].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi8_epi32(_mm_srli_si128(s, 12))), scale), minus_one));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec4(vec_convert_snorm32(in[i]));
+	}
+}
+
+/**
+ * @brief Decodes @p count vectors of four 16 bit signed normalized components, four at a time.
+ * @param in The input array, which need not be aligned.
+ */
+static void vec4_convert_snorm64_array(vec4 *out, const snorm64 *in, size_t count) {
+
+	const vec scale = vec_new(1.f / 32767), minus_one = vec_new(-1);
+
+	const size_t batch = count & ~(size_t) 3;
+	for (size_t i = 0; i < batch; i += 4) {
+		const ivec a = _mm_loadu_si128((const __m128i *) (in + i));
+		const ivec b = _mm_loadu_si128((const __m128i *) (in + i + 2));
+
+		_mm_storeu_ps(out[i + 0].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi16_epi32(a)), scale), minus_one));
+		_mm_storeu_ps(out[i + 1].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi16_epi32(_mm_srli_si128(a, 8))), scale), minus_one));
+		_mm_storeu_ps(out[i + 2].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi16_epi32(b)), scale), minus_one));
+		_mm_storeu_ps(out[i + 3].v, vec_max(vec_multiply(vec_convert_ivec(_mm_cvtepi16_epi32(_mm_srli_si128(b, 8))), scale), minus_one));
+	}
+	for (size_t i = batch; i < count; i++) {
+		out[i] = vec_vec4(vec_convert_snorm64(in[i]));
+	}
+}
+
+#if QUEMATH_F16C
+
+/**
+ * @brief Converts @p count floats to half precision, eight at a time with F16C.
+ * @see half_convert_vec_array
+ */
+QUEMATH_TARGET_F16C static void half_convert_vec_array_f16c(half *out, const float *in, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		_mm_storeu_si128((__m128i *) (out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+	}
+	half_convert_vec_array_sse(out + batch, in + batch, count - batch);
+}
+
+/**
+ * @brief Converts @p count half precision values to floats, eight at a time with F16C.
+ * @see vec_convert_half_array
+ */
+QUEMATH_TARGET_F16C static void vec_convert_half_array_f16c(float *out, const half *in, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (in + i))));
+	}
+	vec_convert_half_array_sse(out + batch, in + batch, count - batch);
+}
+
+#endif
+
 /**
  * @}
  */
+
+#include "vec8.h"
+#include "vec16.h"
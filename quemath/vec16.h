@@ -0,0 +1,475 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include "vec.h"
+
+#if QUEMATH_AVX512
+
+/**
+ * @defgroup vec16 vec16
+ * @brief Sixteen component floating point and integer vectors, for AVX-512.
+ * @details These functions are compiled for AVX-512F regardless of the minimum instruction set
+ * of the build. Call them only from other AVX-512 functions, or after checking cpu_has_avx512.
+ * @{
+ */
+
+/**
+ * @brief Sixteen component floating point AVX-512 vector type.
+ */
+typedef __m512 vec16;
+
+/**
+ * @brief Sixteen component integer AVX-512 vector type.
+ */
+typedef __m512i ivec16;
+
+/**
+ * @brief Sixteen three component vectors in structure of arrays form.
+ * @see vec3x4
+ */
+typedef struct {
+	/**
+	 * @brief Component accessors.
+	 */
+	vec16 x, y, z;
+} vec3x16;
+
+static inline ivec16 ivec16_add(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_and(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_load(const int *in) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_multiply(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_new(int i) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_or(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+static inline void ivec16_store(const ivec16 v, int *out) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_subtract(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+static inline ivec16 ivec16_xor(const ivec16 a, const ivec16 b) QUEMATH_TARGET_AVX512;
+
+static inline vec16 vec16_add(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_divide(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_load(const float *in) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_max(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_min(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_multiply(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_multiply_add(const vec16 a, const vec16 b, const vec16 c) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_multiply_subtract(const vec16 a, const vec16 b, const vec16 c) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_new(float f) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_sqrt(const vec16 v) QUEMATH_TARGET_AVX512;
+static inline void vec16_store(const vec16 v, float *out) QUEMATH_TARGET_AVX512;
+static inline vec16 vec16_subtract(const vec16 a, const vec16 b) QUEMATH_TARGET_AVX512;
+
+static inline vec3x16 vec3x16_add(const vec3x16 a, const vec3x16 b) QUEMATH_TARGET_AVX512;
+static inline vec3x16 vec3x16_cross(const vec3x16 a, const vec3x16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec3x16_distance(const vec3x16 a, const vec3x16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec3x16_dot3(const vec3x16 a, const vec3x16 b) QUEMATH_TARGET_AVX512;
+static inline vec16 vec3x16_length(const vec3x16 v) QUEMATH_TARGET_AVX512;
+static inline vec3x16 vec3x16_load(const vec3 *v) QUEMATH_TARGET_AVX512;
+static inline vec3x16 vec3x16_normalize(const vec3x16 v) QUEMATH_TARGET_AVX512;
+static inline vec3x16 vec3x16_scale_add(const vec3x16 a, const vec3x16 b, float scale) QUEMATH_TARGET_AVX512;
+static inline void vec3x16_store(const vec3x16 v, vec3 *out) QUEMATH_TARGET_AVX512;
+static inline vec3x16 vec3x16_subtract(const vec3x16 a, const vec3x16 b) QUEMATH_TARGET_AVX512;
+
+/**
+ * @brief Calculates the sum of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_add(const ivec16 a, const ivec16 b) {
+	return _mm512_add_epi32(a, b);
+}
+
+/**
+ * @brief Calculates the bitwise and of @p a `&` @p b.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_and(const ivec16 a, const ivec16 b) {
+	return _mm512_and_si512(a, b);
+}
+
+/**
+ * @brief Loads sixteen integers from @p in, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_load(const int *in) {
+	return _mm512_loadu_si512(in);
+}
+
+/**
+ * @brief Calculates the product of @p a `*` @p b, wrapping to the low 32 bits.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_multiply(const ivec16 a, const ivec16 b) {
+	return _mm512_mullo_epi32(a, b);
+}
+
+/**
+ * @brief Creates an integer vector with all sixteen components set to @p i.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_new(int i) {
+	return _mm512_set1_epi32(i);
+}
+
+/**
+ * @brief Calculates the bitwise or of @p a `|` @p b.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_or(const ivec16 a, const ivec16 b) {
+	return _mm512_or_si512(a, b);
+}
+
+/**
+ * @brief Stores the sixteen components of @p v to @p out, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX512 static void ivec16_store(const ivec16 v, int *out) {
+	_mm512_storeu_si512(out, v);
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_subtract(const ivec16 a, const ivec16 b) {
+	return _mm512_sub_epi32(a, b);
+}
+
+/**
+ * @brief Calculates the bitwise exclusive or of @p a `^` @p b.
+ */
+QUEMATH_TARGET_AVX512 static ivec16 ivec16_xor(const ivec16 a, const ivec16 b) {
+	return _mm512_xor_si512(a, b);
+}
+
+/**
+ * @brief Calculates the sum of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_add(const vec16 a, const vec16 b) {
+	return _mm512_add_ps(a, b);
+}
+
+/**
+ * @brief Calculates the quotient of @p a `/` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_divide(const vec16 a, const vec16 b) {
+	return _mm512_div_ps(a, b);
+}
+
+/**
+ * @brief Loads sixteen values from @p in, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_load(const float *in) {
+	return _mm512_loadu_ps(in);
+}
+
+/**
+ * @brief Calculates the maximum values of @p a and @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_max(const vec16 a, const vec16 b) {
+	return _mm512_max_ps(a, b);
+}
+
+/**
+ * @brief Calculates the minimum values of @p a and @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_min(const vec16 a, const vec16 b) {
+	return _mm512_min_ps(a, b);
+}
+
+/**
+ * @brief Calculates the product of @p a `*` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_multiply(const vec16 a, const vec16 b) {
+	return _mm512_mul_ps(a, b);
+}
+
+/**
+ * @brief Calculates @p a `*` @p b `+` @p c.
+ * @details As vec_multiply_add, the product is not rounded before the sum only where
+ * QUEMATH_HAS_FMA is set, so that the results do not vary with the instruction set.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_multiply_add(const vec16 a, const vec16 b, const vec16 c) {
+#if QUEMATH_HAS_FMA
+	return _mm512_fmadd_ps(a, b, c);
+#else
+	return vec16_add(vec16_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Calculates @p a `*` @p b `-` @p c.
+ * @details As vec_multiply_subtract, the product is not rounded before the difference only where
+ * QUEMATH_HAS_FMA is set.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_multiply_subtract(const vec16 a, const vec16 b, const vec16 c) {
+#if QUEMATH_HAS_FMA
+	return _mm512_fmsub_ps(a, b, c);
+#else
+	return vec16_subtract(vec16_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Creates a vector with all sixteen components set to @p f.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_new(float f) {
+	return _mm512_set1_ps(f);
+}
+
+/**
+ * @brief Calculates the square roots of @p v.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_sqrt(const vec16 v) {
+	return _mm512_sqrt_ps(v);
+}
+
+/**
+ * @brief Stores the sixteen components of @p v to @p out, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX512 static void vec16_store(const vec16 v, float *out) {
+	_mm512_storeu_ps(out, v);
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec16_subtract(const vec16 a, const vec16 b) {
+	return _mm512_sub_ps(a, b);
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b.
+ * @return The sixteen sums of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_add(const vec3x16 a, const vec3x16 b) {
+	return (vec3x16) {
+		vec16_add(a.x, b.x),
+		vec16_add(a.y, b.y),
+		vec16_add(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b.
+ * @return The sixteen cross products of @p a `×` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_cross(const vec3x16 a, const vec3x16 b) {
+	return (vec3x16) {
+		vec16_multiply_subtract(a.y, b.z, vec16_multiply(a.z, b.y)),
+		vec16_multiply_subtract(a.z, b.x, vec16_multiply(a.x, b.z)),
+		vec16_multiply_subtract(a.x, b.y, vec16_multiply(a.y, b.x))
+	};
+}
+
+/**
+ * @brief Calculates the distances between the points @p a and @p b.
+ * @return The sixteen distances between @p a and @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec3x16_distance(const vec3x16 a, const vec3x16 b) {
+	return vec3x16_length(vec3x16_subtract(a, b));
+}
+
+/**
+ * @brief Calculates the dot products of @p a `·` @p b.
+ * @return The sixteen dot products of @p a `·` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec3x16_dot3(const vec3x16 a, const vec3x16 b) {
+	return vec16_multiply_add(a.z, b.z, vec16_multiply_add(a.y, b.y, vec16_multiply(a.x, b.x)));
+}
+
+/**
+ * @brief Calculates the lengths of @p v.
+ * @return The sixteen lengths of @p v.
+ */
+QUEMATH_TARGET_AVX512 static vec16 vec3x16_length(const vec3x16 v) {
+	return vec16_sqrt(vec3x16_dot3(v, v));
+}
+
+/**
+ * @brief Loads sixteen three component vectors from @p v, which need not be aligned.
+ * @details Each component is gathered from the three registers by two permutes.
+ * @return The sixteen vectors in structure of arrays form.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_load(const vec3 *v) {
+
+	const float *f = (const float *) v;
+
+	const vec16 a = _mm512_loadu_ps(f + 0);
+	const vec16 b = _mm512_loadu_ps(f + 16);
+	const vec16 c = _mm512_loadu_ps(f + 32);
+
+	const ivec16 x0 = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0);
+	const ivec16 x1 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29);
+	const ivec16 y0 = _mm512_setr_epi32(1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0);
+	const ivec16 y1 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30);
+	const ivec16 z0 = _mm512_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0);
+	const ivec16 z1 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31);
+
+	return (vec3x16) {
+		_mm512_permutex2var_ps(_mm512_permutex2var_ps(a, x0, b), x1, c),
+		_mm512_permutex2var_ps(_mm512_permutex2var_ps(a, y0, b), y1, c),
+		_mm512_permutex2var_ps(_mm512_permutex2var_ps(a, z0, b), z1, c)
+	};
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p v by the square root.
+ * @return Sixteen unit vectors in the same directions of @p v.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_normalize(const vec3x16 v) {
+
+	const vec16 length = vec3x16_length(v);
+
+	return (vec3x16) {
+		vec16_divide(v.x, length),
+		vec16_divide(v.y, length),
+		vec16_divide(v.z, length)
+	};
+}
+
+/**
+ * @brief Calculates the sums of @p a and the scalar products @p b `*` @p scale.
+ * @return The sixteen sums of @p a and @p b `*` @p scale.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_scale_add(const vec3x16 a, const vec3x16 b, float scale) {
+
+	const vec16 s = vec16_new(scale);
+
+	return (vec3x16) {
+		vec16_multiply_add(b.x, s, a.x),
+		vec16_multiply_add(b.y, s, a.y),
+		vec16_multiply_add(b.z, s, a.z)
+	};
+}
+
+/**
+ * @brief Stores the sixteen vectors of @p v to @p out, which need not be aligned.
+ * @details Each register of output is gathered from the three components by two permutes.
+ */
+QUEMATH_TARGET_AVX512 static void vec3x16_store(const vec3x16 v, vec3 *out) {
+
+	const ivec16 a0 = _mm512_setr_epi32(0, 16, 0, 1, 17, 0, 2, 18, 0, 3, 19, 0, 4, 20, 0, 5);
+	const ivec16 a1 = _mm512_setr_epi32(0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15);
+	const ivec16 b0 = _mm512_setr_epi32(21, 0, 6, 22, 0, 7, 23, 0, 8, 24, 0, 9, 25, 0, 10, 26);
+	const ivec16 b1 = _mm512_setr_epi32(0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15);
+	const ivec16 c0 = _mm512_setr_epi32(0, 11, 27, 0, 12, 28, 0, 13, 29, 0, 14, 30, 0, 15, 31, 0);
+	const ivec16 c1 = _mm512_setr_epi32(26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31);
+
+	float *f = (float *) out;
+
+	_mm512_storeu_ps(f + 0, _mm512_permutex2var_ps(_mm512_permutex2var_ps(v.x, a0, v.y), a1, v.z));
+	_mm512_storeu_ps(f + 16, _mm512_permutex2var_ps(_mm512_permutex2var_ps(v.x, b0, v.y), b1, v.z));
+	_mm512_storeu_ps(f + 32, _mm512_permutex2var_ps(_mm512_permutex2var_ps(v.x, c0, v.y), c1, v.z));
+}
+
+/**
+ * @brief Calculates the differences of @p a `-` @p b.
+ * @return The sixteen differences of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX512 static vec3x16 vec3x16_subtract(const vec3x16 a, const vec3x16 b) {
+	return (vec3x16) {
+		vec16_subtract(a.x, b.x),
+		vec16_subtract(a.y, b.y),
+		vec16_subtract(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b for @p count vectors, sixteen at a time.
+ * @see vec3_add_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_add_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec3x16_store(vec3x16_add(vec3x16_load(a + i), vec3x16_load(b + i)), out + i);
+	}
+	vec3_add_array_avx2(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b for @p count vectors, sixteen at a time.
+ * @see vec3_cross_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_cross_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec3x16_store(vec3x16_cross(vec3x16_load(a + i), vec3x16_load(b + i)), out + i);
+	}
+	vec3_cross_array_avx2(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the distances between @p count points @p a and @p b, sixteen at a time.
+ * @see vec3_distance_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_distance_array_avx512(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec16_store(vec3x16_distance(vec3x16_load(a + i), vec3x16_load(b + i)), out + i);
+	}
+	vec3_distance_array_avx2(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the dot products of @p a `·` @p b for @p count vectors, sixteen at a time.
+ * @see vec3_dot3_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_dot3_array_avx512(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec16_store(vec3x16_dot3(vec3x16_load(a + i), vec3x16_load(b + i)), out + i);
+	}
+	vec3_dot3_array_avx2(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the lengths of @p count vectors, sixteen at a time.
+ * @see vec3_length_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_length_array_avx512(float *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec16_store(vec3x16_length(vec3x16_load(v + i)), out + i);
+	}
+	vec3_length_array_avx2(out + batch, v + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p count vectors, sixteen at a time.
+ * @see vec3_normalize_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_normalize_array_avx512(vec3 *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec3x16_store(vec3x16_normalize(vec3x16_load(v + i)), out + i);
+	}
+	vec3_normalize_array_avx2(out + batch, v + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the sums of @p a and @p b `*` @p scale for @p count vectors, sixteen at a time.
+ * @see vec3_scale_add_array
+ */
+QUEMATH_TARGET_AVX512 static void vec3_scale_add_array_avx512(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) {
+	const size_t batch = count & ~(size_t) 15;
+	for (size_t i = 0; i < batch; i += 16) {
+		vec3x16_store(vec3x16_scale_add(vec3x16_load(a + i), vec3x16_load(b + i), scale), out + i);
+	}
+	vec3_scale_add_array_avx2(out + batch, a + batch, b + batch, scale, count - batch);
+}
+
+/** @} */
+
+#endif
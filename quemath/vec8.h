@@ -0,0 +1,477 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include "vec.h"
+
+#if QUEMATH_AVX2
+
+/**
+ * @defgroup vec8 vec8
+ * @brief Eight component floating point and integer vectors, for AVX2.
+ * @details These functions are compiled for AVX2 and FMA regardless of the minimum instruction set
+ * of the build. Call them only from other AVX2 functions, or after checking cpu_has_avx2.
+ * @{
+ */
+
+/**
+ * @brief Eight component floating point AVX vector type.
+ */
+typedef __m256 vec8;
+
+/**
+ * @brief Eight component integer AVX2 vector type.
+ */
+typedef __m256i ivec8;
+
+/**
+ * @brief Eight three component vectors in structure of arrays form.
+ * @see vec3x4
+ */
+typedef struct {
+	/**
+	 * @brief Component accessors.
+	 */
+	vec8 x, y, z;
+} vec3x8;
+
+static inline ivec8 ivec8_add(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_and(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_load(const int *in) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_multiply(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_new(int i) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_or(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+static inline void ivec8_store(const ivec8 v, int *out) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_subtract(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+static inline ivec8 ivec8_xor(const ivec8 a, const ivec8 b) QUEMATH_TARGET_AVX2;
+
+static inline vec8 vec8_add(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_divide(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_load(const float *in) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_max(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_min(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_multiply(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_multiply_add(const vec8 a, const vec8 b, const vec8 c) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_multiply_subtract(const vec8 a, const vec8 b, const vec8 c) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_new(float f) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_sqrt(const vec8 v) QUEMATH_TARGET_AVX2;
+static inline void vec8_store(const vec8 v, float *out) QUEMATH_TARGET_AVX2;
+static inline vec8 vec8_subtract(const vec8 a, const vec8 b) QUEMATH_TARGET_AVX2;
+
+static inline vec3x8 vec3x8_add(const vec3x8 a, const vec3x8 b) QUEMATH_TARGET_AVX2;
+static inline vec3x8 vec3x8_cross(const vec3x8 a, const vec3x8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec3x8_distance(const vec3x8 a, const vec3x8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec3x8_dot3(const vec3x8 a, const vec3x8 b) QUEMATH_TARGET_AVX2;
+static inline vec8 vec3x8_length(const vec3x8 v) QUEMATH_TARGET_AVX2;
+static inline vec3x8 vec3x8_load(const vec3 *v) QUEMATH_TARGET_AVX2;
+static inline vec3x8 vec3x8_normalize(const vec3x8 v) QUEMATH_TARGET_AVX2;
+static inline vec3x8 vec3x8_scale_add(const vec3x8 a, const vec3x8 b, float scale) QUEMATH_TARGET_AVX2;
+static inline void vec3x8_store(const vec3x8 v, vec3 *out) QUEMATH_TARGET_AVX2;
+static inline vec3x8 vec3x8_subtract(const vec3x8 a, const vec3x8 b) QUEMATH_TARGET_AVX2;
+
+/**
+ * @brief Calculates the sum of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_add(const ivec8 a, const ivec8 b) {
+	return _mm256_add_epi32(a, b);
+}
+
+/**
+ * @brief Calculates the bitwise and of @p a `&` @p b.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_and(const ivec8 a, const ivec8 b) {
+	return _mm256_and_si256(a, b);
+}
+
+/**
+ * @brief Loads eight integers from @p in, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_load(const int *in) {
+	return _mm256_loadu_si256((const __m256i *) in);
+}
+
+/**
+ * @brief Calculates the product of @p a `*` @p b, wrapping to the low 32 bits.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_multiply(const ivec8 a, const ivec8 b) {
+	return _mm256_mullo_epi32(a, b);
+}
+
+/**
+ * @brief Creates an integer vector with all eight components set to @p i.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_new(int i) {
+	return _mm256_set1_epi32(i);
+}
+
+/**
+ * @brief Calculates the bitwise or of @p a `|` @p b.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_or(const ivec8 a, const ivec8 b) {
+	return _mm256_or_si256(a, b);
+}
+
+/**
+ * @brief Stores the eight components of @p v to @p out, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX2 static void ivec8_store(const ivec8 v, int *out) {
+	_mm256_storeu_si256((__m256i *) out, v);
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_subtract(const ivec8 a, const ivec8 b) {
+	return _mm256_sub_epi32(a, b);
+}
+
+/**
+ * @brief Calculates the bitwise exclusive or of @p a `^` @p b.
+ */
+QUEMATH_TARGET_AVX2 static ivec8 ivec8_xor(const ivec8 a, const ivec8 b) {
+	return _mm256_xor_si256(a, b);
+}
+
+/**
+ * @brief Calculates the sum of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_add(const vec8 a, const vec8 b) {
+	return _mm256_add_ps(a, b);
+}
+
+/**
+ * @brief Calculates the quotient of @p a `/` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_divide(const vec8 a, const vec8 b) {
+	return _mm256_div_ps(a, b);
+}
+
+/**
+ * @brief Loads eight values from @p in, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_load(const float *in) {
+	return _mm256_loadu_ps(in);
+}
+
+/**
+ * @brief Calculates the maximum values of @p a and @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_max(const vec8 a, const vec8 b) {
+	return _mm256_max_ps(a, b);
+}
+
+/**
+ * @brief Calculates the minimum values of @p a and @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_min(const vec8 a, const vec8 b) {
+	return _mm256_min_ps(a, b);
+}
+
+/**
+ * @brief Calculates the product of @p a `*` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_multiply(const vec8 a, const vec8 b) {
+	return _mm256_mul_ps(a, b);
+}
+
+/**
+ * @brief Calculates @p a `*` @p b `+` @p c.
+ * @details As vec_multiply_add, the product is not rounded before the sum only where
+ * QUEMATH_HAS_FMA is set, so that the results do not vary with the instruction set.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_multiply_add(const vec8 a, const vec8 b, const vec8 c) {
+#if QUEMATH_HAS_FMA
+	return _mm256_fmadd_ps(a, b, c);
+#else
+	return vec8_add(vec8_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Calculates @p a `*` @p b `-` @p c.
+ * @details As vec_multiply_subtract, the product is not rounded before the difference only where
+ * QUEMATH_HAS_FMA is set.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_multiply_subtract(const vec8 a, const vec8 b, const vec8 c) {
+#if QUEMATH_HAS_FMA
+	return _mm256_fmsub_ps(a, b, c);
+#else
+	return vec8_subtract(vec8_multiply(a, b), c);
+#endif
+}
+
+/**
+ * @brief Creates a vector with all eight components set to @p f.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_new(float f) {
+	return _mm256_set1_ps(f);
+}
+
+/**
+ * @brief Calculates the square roots of @p v.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_sqrt(const vec8 v) {
+	return _mm256_sqrt_ps(v);
+}
+
+/**
+ * @brief Stores the eight components of @p v to @p out, which need not be aligned.
+ */
+QUEMATH_TARGET_AVX2 static void vec8_store(const vec8 v, float *out) {
+	_mm256_storeu_ps(out, v);
+}
+
+/**
+ * @brief Calculates the difference of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec8_subtract(const vec8 a, const vec8 b) {
+	return _mm256_sub_ps(a, b);
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b.
+ * @return The eight sums of @p a `+` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_add(const vec3x8 a, const vec3x8 b) {
+	return (vec3x8) {
+		vec8_add(a.x, b.x),
+		vec8_add(a.y, b.y),
+		vec8_add(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b.
+ * @return The eight cross products of @p a `×` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_cross(const vec3x8 a, const vec3x8 b) {
+	return (vec3x8) {
+		vec8_multiply_subtract(a.y, b.z, vec8_multiply(a.z, b.y)),
+		vec8_multiply_subtract(a.z, b.x, vec8_multiply(a.x, b.z)),
+		vec8_multiply_subtract(a.x, b.y, vec8_multiply(a.y, b.x))
+	};
+}
+
+/**
+ * @brief Calculates the distances between the points @p a and @p b.
+ * @return The eight distances between @p a and @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec3x8_distance(const vec3x8 a, const vec3x8 b) {
+	return vec3x8_length(vec3x8_subtract(a, b));
+}
+
+/**
+ * @brief Calculates the dot products of @p a `·` @p b.
+ * @return The eight dot products of @p a `·` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec3x8_dot3(const vec3x8 a, const vec3x8 b) {
+	return vec8_multiply_add(a.z, b.z, vec8_multiply_add(a.y, b.y, vec8_multiply(a.x, b.x)));
+}
+
+/**
+ * @brief Calculates the lengths of @p v.
+ * @return The eight lengths of @p v.
+ */
+QUEMATH_TARGET_AVX2 static vec8 vec3x8_length(const vec3x8 v) {
+	return vec8_sqrt(vec3x8_dot3(v, v));
+}
+
+/**
+ * @brief Loads eight three component vectors from @p v, which need not be aligned.
+ * @details Each 128 bit lane is transposed as in vec3x4_load.
+ * @return The eight vectors in structure of arrays form.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_load(const vec3 *v) {
+
+	const float *f = (const float *) v;
+
+	const vec8 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 0)), _mm_loadu_ps(f + 12), 1);
+	const vec8 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 4)), _mm_loadu_ps(f + 16), 1);
+	const vec8 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(f + 8)), _mm_loadu_ps(f + 20), 1);
+
+	const vec8 b2c1 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+	const vec8 a1b0 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+	const vec8 b3c2 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+	const vec8 a2b1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+
+	return (vec3x8) {
+		_mm256_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0)),
+		_mm256_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm256_shuffle_ps(a2b1, c, _MM_SHUFFLE(3, 0, 2, 0))
+	};
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p v by the square root.
+ * @return Eight unit vectors in the same directions of @p v.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_normalize(const vec3x8 v) {
+
+	const vec8 length = vec3x8_length(v);
+
+	return (vec3x8) {
+		vec8_divide(v.x, length),
+		vec8_divide(v.y, length),
+		vec8_divide(v.z, length)
+	};
+}
+
+/**
+ * @brief Calculates the sums of @p a and the scalar products @p b `*` @p scale.
+ * @return The eight sums of @p a and @p b `*` @p scale.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_scale_add(const vec3x8 a, const vec3x8 b, float scale) {
+
+	const vec8 s = vec8_new(scale);
+
+	return (vec3x8) {
+		vec8_multiply_add(b.x, s, a.x),
+		vec8_multiply_add(b.y, s, a.y),
+		vec8_multiply_add(b.z, s, a.z)
+	};
+}
+
+/**
+ * @brief Stores the eight vectors of @p v to @p out, which need not be aligned.
+ * @details Each 128 bit lane is transposed as in vec3x4_store.
+ */
+QUEMATH_TARGET_AVX2 static void vec3x8_store(const vec3x8 v, vec3 *out) {
+
+	const vec8 x0y0 = _mm256_shuffle_ps(v.x, v.y, _MM_SHUFFLE(0, 0, 0, 0));
+	const vec8 z0x1 = _mm256_shuffle_ps(v.z, v.x, _MM_SHUFFLE(1, 1, 0, 0));
+	const vec8 y1z1 = _mm256_shuffle_ps(v.y, v.z, _MM_SHUFFLE(1, 1, 1, 1));
+	const vec8 x2y2 = _mm256_shuffle_ps(v.x, v.y, _MM_SHUFFLE(2, 2, 2, 2));
+	const vec8 z2x3 = _mm256_shuffle_ps(v.z, v.x, _MM_SHUFFLE(3, 3, 2, 2));
+	const vec8 y3z3 = _mm256_shuffle_ps(v.y, v.z, _MM_SHUFFLE(3, 3, 3, 3));
+
+	const vec8 a = _mm256_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0));
+	const vec8 b = _mm256_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0));
+	const vec8 c = _mm256_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0));
+
+	float *f = (float *) out;
+
+	_mm256_storeu_ps(f + 0, _mm256_permute2f128_ps(a, b, 0x20));
+	_mm256_storeu_ps(f + 8, _mm256_permute2f128_ps(c, a, 0x30));
+	_mm256_storeu_ps(f + 16, _mm256_permute2f128_ps(b, c, 0x31));
+}
+
+/**
+ * @brief Calculates the differences of @p a `-` @p b.
+ * @return The eight differences of @p a `-` @p b.
+ */
+QUEMATH_TARGET_AVX2 static vec3x8 vec3x8_subtract(const vec3x8 a, const vec3x8 b) {
+	return (vec3x8) {
+		vec8_subtract(a.x, b.x),
+		vec8_subtract(a.y, b.y),
+		vec8_subtract(a.z, b.z)
+	};
+}
+
+/**
+ * @brief Calculates the sums of @p a `+` @p b for @p count vectors, eight at a time.
+ * @see vec3_add_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_add_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec3x8_store(vec3x8_add(vec3x8_load(a + i), vec3x8_load(b + i)), out + i);
+	}
+	vec3_add_array_sse(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the cross products of @p a `×` @p b for @p count vectors, eight at a time.
+ * @see vec3_cross_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_cross_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec3x8_store(vec3x8_cross(vec3x8_load(a + i), vec3x8_load(b + i)), out + i);
+	}
+	vec3_cross_array_sse(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the distances between @p count points @p a and @p b, eight at a time.
+ * @see vec3_distance_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_distance_array_avx2(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec8_store(vec3x8_distance(vec3x8_load(a + i), vec3x8_load(b + i)), out + i);
+	}
+	vec3_distance_array_sse(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the dot products of @p a `·` @p b for @p count vectors, eight at a time.
+ * @see vec3_dot3_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_dot3_array_avx2(float *out, const vec3 *a, const vec3 *b, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec8_store(vec3x8_dot3(vec3x8_load(a + i), vec3x8_load(b + i)), out + i);
+	}
+	vec3_dot3_array_sse(out + batch, a + batch, b + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the lengths of @p count vectors, eight at a time.
+ * @see vec3_length_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_length_array_avx2(float *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec8_store(vec3x8_length(vec3x8_load(v + i)), out + i);
+	}
+	vec3_length_array_sse(out + batch, v + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the unit length vectors of @p count vectors, eight at a time.
+ * @see vec3_normalize_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_normalize_array_avx2(vec3 *out, const vec3 *v, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec3x8_store(vec3x8_normalize(vec3x8_load(v + i)), out + i);
+	}
+	vec3_normalize_array_sse(out + batch, v + batch, count - batch);
+}
+
+/**
+ * @brief Calculates the sums of @p a and @p b `*` @p scale for @p count vectors, eight at a time.
+ * @see vec3_scale_add_array
+ */
+QUEMATH_TARGET_AVX2 static void vec3_scale_add_array_avx2(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count) {
+	const size_t batch = count & ~(size_t) 7;
+	for (size_t i = 0; i < batch; i += 8) {
+		vec3x8_store(vec3x8_scale_add(vec3x8_load(a + i), vec3x8_load(b + i), scale), out + i);
+	}
+	vec3_scale_add_array_sse(out + batch, a + batch, b + batch, scale, count - batch);
+}
+
+/** @} */
+
+#endif
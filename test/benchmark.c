@@ -23,10 +23,27 @@
 
 #include <check.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 #include "quemath.h"
 
+#if defined(QUEMATH_LIBRARY)
+ #include "library.h"
+#endif
+
+#if QUEMATH_HAS_FMA
+ #define FMA " FMA"
+#else
+ #define FMA ""
+#endif
+
+#if QUEMATH_DOT == QUEMATH_DOT_DPPS
+ #define DOT " dpps"
+#else
+ #define DOT " shuffle"
+#endif
+
 #define TIME_BLOCK(name, block) { \
 	const clock_t start = clock(); \
  	\
@@ -37,6 +54,22 @@
 	printf("%s: %.9f seconds\n", name, (end - start) / (double) CLOCKS_PER_SEC); \
 }
 
+#define TIME_BLOCK_BYTES(name, bytes, block) { \
+	const clock_t start = clock(); \
+	\
+	block \
+	\
+	const clock_t end = clock(); \
+	\
+	const double seconds = (end - start) / (double) CLOCKS_PER_SEC; \
+	printf("%s: %.9f seconds, %.2f GB/s\n", name, seconds, (bytes) / seconds / 1e9); \
+}
+
+/**
+ * @brief Keeps the results of latency bound loops from being optimized away.
+ */
+static volatile float sink;
+
 static vec *vectors(size_t count) {
 	return calloc(count, sizeof(vec));
 }
@@ -102,7 +135,7 @@ START_TEST(_vec_dot) {
 	free(v);
 	v = random_vectors(iterations);
 
-	TIME_BLOCK("Dot product SSE", {
+	TIME_BLOCK("Dot product SSE" DOT, {
 		for (int i = 0; i < iterations; i++) {
 			const vec a = v[(i + 0) % iterations];
 			const vec b = v[(i + 1) % iterations];
@@ -113,6 +146,60 @@ START_TEST(_vec_dot) {
 
 	free(v);
 
+	const int count = 1024;
+	const int repeats = 40000;
+
+	vec a[count + 4];
+	float d[count];
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (int i = 0; i < count + 4; i++) {
+		a[i] = rand = vec_random(rand);
+	}
+
+	TIME_BLOCK("Dot product throughput dpps", {
+		for (int j = 0; j < repeats; j++) {
+			for (int i = 0; i < count; i++) {
+				d[i] = vec_x(_mm_dp_ps(a[i], a[i + 1], 0x71));
+			}
+		}
+	});
+
+	TIME_BLOCK("Dot product throughput SSE" DOT, {
+		for (int j = 0; j < repeats; j++) {
+			for (int i = 0; i < count; i++) {
+				d[i] = vec_x(vec_dot3(a[i], a[i + 1]));
+			}
+		}
+	});
+
+	TIME_BLOCK("Dot product throughput SSE vec_dot3x4", {
+		for (int j = 0; j < repeats; j++) {
+			for (int i = 0; i < count; i += 4) {
+				_mm_storeu_ps(d + i, vec_dot3x4(a + i, a + i + 1));
+			}
+		}
+	});
+
+	sink = d[count - 1];
+
+	// each dot product depends upon the last, and is scaled to keep the chain bounded
+	TIME_BLOCK("Dot product latency dpps", {
+		vec x = a[0];
+		for (int i = 0; i < repeats * count; i++) {
+			x = vec_multiply_add(_mm_dp_ps(x, a[1], 0x7F), vec_new(.25), a[2]);
+		}
+		sink = vec_x(x);
+	});
+
+	TIME_BLOCK("Dot product latency SSE" DOT, {
+		vec x = a[0];
+		for (int i = 0; i < repeats * count; i++) {
+			x = vec_multiply_add(vec_dot3_broadcast(x, a[1]), vec_new(.25), a[2]);
+		}
+		sink = vec_x(x);
+	});
+
 } END_TEST
 
 static vec VectorNormalize(vec v) {
@@ -158,6 +245,91 @@ START_TEST(_vec_normalize) {
 	});
 
 	free(v);
+	v = random_vectors(iterations);
+
+	vec3 *v3 = calloc(iterations, sizeof(vec3));
+	for (int i = 0; i < iterations; i++) {
+		v3[i] = vec_vec3(v[i]);
+	}
+
+	TIME_BLOCK("Vector normalize array SSE", {
+		vec3_normalize_array(v3, v3, iterations);
+	});
+
+	free(v3);
+	free(v);
+
+} END_TEST
+
+static double rcp(double x) {
+	return 1 / x;
+}
+
+static double rsqrt(double x) {
+	return 1 / sqrt(x);
+}
+
+/**
+ * @brief Measures the largest error of @p f against @p reference in ULP, across `[1, 4)`.
+ */
+static int max_ulp(vec (*f)(const vec), double (*reference)(double)) {
+
+	int max = 0;
+	for (float x = 1; x < 4; x = nextafterf(x, 4)) {
+		const float y = vec_x(f(vec_new(x)));
+		const float expected = reference(x);
+
+		int a, b;
+		memcpy(&a, &y, sizeof(a));
+		memcpy(&b, &expected, sizeof(b));
+
+		max = abs(a - b) > max ? abs(a - b) : max;
+	}
+
+	return max;
+}
+
+/**
+ * @brief Times @p f bound by throughput, over a cached buffer, and by latency, over a dependency
+ * chain, and then reports its largest error.
+ */
+#define TIME_PRECISION(name, f, reference, v, out, count, iterations) { \
+	TIME_BLOCK(name " throughput", { \
+		for (int j = 0; j < iterations; j++) { \
+			for (int i = 0; i < count; i += 4) { \
+				_mm_storeu_ps(out + i, f(_mm_loadu_ps(v + i))); \
+			} \
+		} \
+	}); \
+	TIME_BLOCK(name " latency", { \
+		vec x = vec_new(2); \
+		for (int j = 0; j < iterations * count / 4; j++) { \
+			x = f(x); \
+		} \
+		sink = vec_x(x); \
+	}); \
+	printf("%s error: %d ulp\n", name, max_ulp(f, reference)); \
+}
+
+START_TEST(_vec_rsqrt) {
+
+	const int count = 1024;
+	const int iterations = 40000;
+
+	float v[count];
+	float out[count];
+
+	for (int i = 0; i < count; i++) {
+		v[i] = 1 + i * (3.f / count);
+	}
+
+	TIME_PRECISION("Vector rcp estimate", vec_rcp_estimate, rcp, v, out, count, iterations);
+	TIME_PRECISION("Vector rcp refined" FMA, vec_rcp_refined, rcp, v, out, count, iterations);
+	TIME_PRECISION("Vector rcp precise", vec_rcp_precise, rcp, v, out, count, iterations);
+
+	TIME_PRECISION("Vector rsqrt estimate", vec_rsqrt_estimate, rsqrt, v, out, count, iterations);
+	TIME_PRECISION("Vector rsqrt refined" FMA, vec_rsqrt_refined, rsqrt, v, out, count, iterations);
+	TIME_PRECISION("Vector rsqrt precise", vec_rsqrt_precise, rsqrt, v, out, count, iterations);
 
 } END_TEST
 
@@ -181,7 +353,7 @@ START_TEST(_vec_scale_add) {
 	free(v);
 	v = random_vectors(iterations);
 
-	TIME_BLOCK("Vector scale add SSE", {
+	TIME_BLOCK("Vector scale add SSE" FMA, {
 		for (int i = 0; i < iterations; i++) {
 			const vec a = v[(i + 0) % iterations];
 			const vec b = v[(i + 1) % iterations];
@@ -190,17 +362,939 @@ START_TEST(_vec_scale_add) {
 	});
 
 	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector mix SSE" FMA, {
+		for (int i = 0; i < iterations; i++) {
+			const vec a = v[(i + 0) % iterations];
+			const vec b = v[(i + 1) % iterations];
+			v[(i + 2) % iterations] = vec_mix(a, b, 0.25);
+		}
+	});
+
+	free(v);
+
+	const int particles = 100000;
+	vec *position = random_vectors(particles);
+	vec *velocity = random_vectors(particles);
+
+	TIME_BLOCK("Vector integrate SSE" FMA, {
+		const vec gravity = vec3f(0, 0, -800);
+		for (int step = 0; step < 100; step++) {
+			for (int i = 0; i < particles; i++) {
+				velocity[i] = vec_scale_add(velocity[i], gravity, 0.001);
+				position[i] = vec_scale_add(position[i], velocity[i], 0.001);
+			}
+		}
+	});
+
+	vec3 *p3 = calloc(particles, sizeof(vec3));
+	vec3 *v3 = calloc(particles, sizeof(vec3));
+	for (int i = 0; i < particles; i++) {
+		p3[i] = vec_vec3(position[i]);
+		v3[i] = vec_vec3(velocity[i]);
+	}
+
+	TIME_BLOCK("Vector integrate array SSE" FMA, {
+		for (int step = 0; step < 100; step++) {
+			vec3_scale_add_array_sse(p3, p3, v3, 0.001, particles);
+		}
+	});
+
+	free(p3);
+	free(v3);
+	free(position);
+	free(velocity);
 
 } END_TEST
 
-int main(int argc, char **argv) {
+START_TEST(_vec_sinf) {
+
+	const int iterations = 10000000;
+	vec *v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector sine", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec4f(sinf(v[i][0]), sinf(v[i][1]), sinf(v[i][2]), sinf(v[i][3]));
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector sine SSE", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec_sinf(v[i]);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector sine fast SSE", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec_sinf_fast(v[i]);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector sine and cosine SSE", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec_add(vec_sinf(v[i]), vec_cosf(v[i]));
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector sincos SSE", {
+		for (int i = 0; i < iterations; i++) {
+			vec s;
+			vec c;
+			vec_sincosf(v[i], &s, &c);
+			v[i] = vec_add(s, c);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector tangent", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec4f(tanf(v[i][0]), tanf(v[i][1]), tanf(v[i][2]), tanf(v[i][3]));
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector tangent SSE", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec_tanf(v[i]);
+		}
+	});
+
+	free(v);
+
+} END_TEST
+
+START_TEST(_vec_atan2f) {
+
+	const int iterations = 10000000;
+	vec *v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector arc tangent 2", {
+		for (int i = 0; i < iterations - 1; i++) {
+			const vec a = v[i];
+			const vec b = v[i + 1];
+			v[i] = vec4f(atan2f(a[0], b[0]), atan2f(a[1], b[1]), atan2f(a[2], b[2]), atan2f(a[3], b[3]));
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector arc tangent 2 SSE", {
+		for (int i = 0; i < iterations - 1; i++) {
+			v[i] = vec_atan2f(v[i], v[i + 1]);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector arc sine", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec4f(asinf(v[i][0]), asinf(v[i][1]), asinf(v[i][2]), asinf(v[i][3]));
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Vector arc sine SSE", {
+		for (int i = 0; i < iterations; i++) {
+			v[i] = vec_asinf(v[i]);
+		}
+	});
+
+	free(v);
+
+} END_TEST
+
+static void Matrix4x4_Concat(float out[4][4], const float a[4][4], const float b[4][4]) {
+	for (int i = 0; i < 4; i++) {
+		for (int j = 0; j < 4; j++) {
+			out[i][j] = a[0][j] * b[i][0] + a[1][j] * b[i][1] + a[2][j] * b[i][2] + a[3][j] * b[i][3];
+		}
+	}
+}
+
+START_TEST(_vec_convert_half) {
+
+	const int iterations = 10000000;
+	vec3 *v = calloc(iterations, sizeof(vec3));
+	vec3 *out = calloc(iterations, sizeof(vec3));
+	half *h = calloc(iterations * 3, sizeof(half));
+
+	for (int i = 0; i < iterations; i++) {
+		v[i] = (vec3) { .v = { i * .001f, -i * .5f, i % 1000 } };
+	}
+
+	memset(out, 0, iterations * sizeof(vec3));
+	memset(h, 0, iterations * 3 * sizeof(half));
+
+	TIME_BLOCK_BYTES("Vector to half soft", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		for (int i = 0; i < iterations * 3; i++) {
+			h[i] = (half) _mm_extract_epi16(half_convert_vec_soft(vec1f(((float *) v)[i])), 0);
+		}
+	});
+
+	TIME_BLOCK_BYTES("Vector to half soft SSE", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		for (int i = 0; i < iterations * 3; i += 4) {
+			_mm_storel_epi64((__m128i *) (h + i), half_convert_vec_soft(_mm_loadu_ps((float *) v + i)));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Vector to half array SSE", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		half_convert_vec_array_sse(h, (const float *) v, iterations * 3);
+	});
+
+	TIME_BLOCK_BYTES("Vector to half array", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		half_convert_vec3_array(h, v, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Half to vector soft SSE", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		for (int i = 0; i < iterations * 3; i += 4) {
+			_mm_storeu_ps((float *) out + i, vec_convert_half_soft(_mm_loadl_epi64((__m128i *) (h + i))));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Half to vector array SSE", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		vec_convert_half_array_sse((float *) out, h, iterations * 3);
+	});
+
+	TIME_BLOCK_BYTES("Half to vector array", iterations * (sizeof(vec3) + 3 * sizeof(half)), {
+		vec3_convert_half_array(out, h, iterations);
+	});
+
+	free(v);
+	free(out);
+	free(h);
+
+} END_TEST
+
+START_TEST(_vec_convert_oct) {
+
+	const int iterations = 10000000;
+	vec3 *v = calloc(iterations, sizeof(vec3));
+	vec3 *out = calloc(iterations, sizeof(vec3));
+	oct16 *o16 = calloc(iterations, sizeof(oct16));
+	oct32 *o32 = calloc(iterations, sizeof(oct32));
+
+	for (int i = 0; i < iterations; i++) {
+		v[i] = vec_vec3(vec_normalize(vec3f(i * .001f - 5000, (i % 1000) - 500.f, 1 - (i % 3))));
+	}
+
+	memset(out, 0, iterations * sizeof(vec3));
+	memset(o16, 0, iterations * sizeof(oct16));
+	memset(o32, 0, iterations * sizeof(oct32));
+
+	TIME_BLOCK_BYTES("Vector to oct16 single", iterations * (sizeof(vec3) + sizeof(oct16)), {
+		for (int i = 0; i < iterations; i++) {
+			o16[i] = oct16_convert_vec(vec3fv(v[i]));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Vector to oct16 array", iterations * (sizeof(vec3) + sizeof(oct16)), {
+		oct16_convert_vec3_array(o16, v, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Vector to oct32 array", iterations * (sizeof(vec3) + sizeof(oct32)), {
+		oct32_convert_vec3_array(o32, v, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Oct16 to vector array", iterations * (sizeof(vec3) + sizeof(oct16)), {
+		vec3_convert_oct16_array(out, o16, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Oct32 to vector array", iterations * (sizeof(vec3) + sizeof(oct32)), {
+		vec3_convert_oct32_array(out, o32, iterations);
+	});
+
+	free(v);
+	free(out);
+	free(o16);
+	free(o32);
+
+} END_TEST
+
+START_TEST(_vec_convert_dvec) {
+
+	const int iterations = 10000000;
+	dvec3 *d = calloc(iterations, sizeof(dvec3));
+	vec3 *out = calloc(iterations, sizeof(vec3));
+
+	const dvec3 origin = { .v = { 1e7, -2e7, 3e5 } };
+	for (int i = 0; i < iterations; i++) {
+		d[i] = (dvec3) { .v = { origin.x + i * .001, origin.y - (i % 1000), origin.z + i } };
+	}
+
+	memset(out, 0, iterations * sizeof(vec3));
+
+	TIME_BLOCK_BYTES("Double vector to relative vector single", iterations * (sizeof(dvec3) + sizeof(vec3)), {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = vec_vec3(vec_convert_dvec_relative(dvec3fv(d[i]), dvec3fv(origin)));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Double vector to relative vector array SSE", iterations * (sizeof(dvec3) + sizeof(vec3)), {
+		vec3_convert_dvec3_relative_array_sse(out, d, origin, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Double vector to relative vector array", iterations * (sizeof(dvec3) + sizeof(vec3)), {
+		vec3_convert_dvec3_relative_array(out, d, origin, iterations);
+	});
+
+	free(d);
+	free(out);
+
+} END_TEST
+
+START_TEST(_random_fill) {
+
+	const int iterations = 40000000;
+	float *f = calloc(iterations, sizeof(float));
+
+	memset(f, 0, iterations * sizeof(float));
+
+	TIME_BLOCK_BYTES("Random float rand", iterations * sizeof(float), {
+		for (int i = 0; i < iterations; i++) {
+			f[i] = rand() / (RAND_MAX + 1.f);
+		}
+	});
+
+	TIME_BLOCK_BYTES("Random float vec_random", iterations * sizeof(float), {
+		vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_ps(f + i, rand = vec_random(rand));
+		}
+	});
+
+	random4 r4 = random4_new(0xfeed);
+	random8 r8 = random8_new(0xfeed);
+
+	TIME_BLOCK_BYTES("Random float random4", iterations * sizeof(float), {
+		random4_fill_float(&r4, f, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Random float random8", iterations * sizeof(float), {
+		random8_fill_float(&r8, f, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Random integer random8", iterations * sizeof(uint32_t), {
+		random8_fill(&r8, (uint32_t *) f, iterations);
+	});
+
+	free(f);
+
+} END_TEST
+
+START_TEST(_random_range) {
+
+	const int iterations = 40000000;
+	int *out = calloc(iterations, sizeof(int));
+
+	memset(out, 0, iterations * sizeof(int));
+
+	TIME_BLOCK_BYTES("Random range rand", iterations * sizeof(int), {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = 100 + rand() % 1000;
+		}
+	});
+
+	const ivec mins = ivec_new(100);
+	const ivec maxs = ivec_new(1100);
+
+	TIME_BLOCK_BYTES("Random range ivec_random_range", iterations * sizeof(int), {
+		ivec rand = ivec4i(0xfeed, 0xdad, 0xdead, 0xbeef);
+		for (int i = 0; i < iterations; i += 4) {
+			rand = ivec_random(rand);
+			_mm_storeu_si128((__m128i *) (out + i), ivec_random_range(rand, mins, maxs));
+		}
+	});
+
+	random4 r = random4_new(0xfeed);
+
+	TIME_BLOCK_BYTES("Random range random4", iterations * sizeof(int), {
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), random4_next_range(&r, mins, maxs));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Random range random4 unbiased", iterations * sizeof(int), {
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), random4_next_range_unbiased(&r, mins, maxs));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Random float range random4", iterations * sizeof(float), {
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_ps((float *) out + i, random4_next_float_range(&r, vec_new(-1), vec_new(1)));
+		}
+	});
+
+	free(out);
+
+} END_TEST
+
+START_TEST(_ivec_divide) {
+
+	const int iterations = 40000000;
+	int *in = calloc(iterations, sizeof(int));
+	int *out = calloc(iterations, sizeof(int));
+
+	for (int i = 0; i < iterations; i++) {
+		in[i] = i - iterations / 2;
+	}
+
+	memset(out, 0, iterations * sizeof(int));
+
+	TIME_BLOCK_BYTES("Integer modulo scalar", iterations * 2 * sizeof(int), {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = in[i] % 24;
+		}
+	});
+
+	TIME_BLOCK_BYTES("Integer modulo ivec_modulo", iterations * 2 * sizeof(int), {
+		const ivec divisor = ivec_new(24);
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), ivec_modulo(_mm_loadu_si128((__m128i *) (in + i)), divisor));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Integer modulo ivec_remainder", iterations * 2 * sizeof(int), {
+		const ivec_divisor divisor = ivec_divisor_new(24);
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), ivec_remainder(_mm_loadu_si128((__m128i *) (in + i)), divisor));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Integer floor divide ivec_floor_divide", iterations * 2 * sizeof(int), {
+		const ivec_divisor divisor = ivec_divisor_new(24);
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), ivec_floor_divide(_mm_loadu_si128((__m128i *) (in + i)), divisor));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Integer floor divide ivec_floor_divide power of two", iterations * 2 * sizeof(int), {
+		const ivec_divisor divisor = ivec_divisor_new(16);
+		for (int i = 0; i < iterations; i += 4) {
+			_mm_storeu_si128((__m128i *) (out + i), ivec_floor_divide(_mm_loadu_si128((__m128i *) (in + i)), divisor));
+		}
+	});
+
+	free(in);
+	free(out);
+
+} END_TEST
+
+START_TEST(_library_dispatch) {
+#if defined(QUEMATH_LIBRARY)
+
+	const int iterations = 10000000;
+	vec3 a[17], b[17];
+	float out[16];
+
+	for (int i = 0; i < 17; i++) {
+		a[i] = vec_vec3(vec3f(i, i + 1, i + 2));
+		b[i] = vec_vec3(vec3f(i + 2, i, i + 1));
+	}
+
+	printf("Library dispatch ISA: %s\n", quemath_isa());
+
+	// each exported kernel runs this once, when the library is loaded
+	volatile int isa = 0;
+	TIME_BLOCK("Library dispatch resolve, 1000000 times", {
+		for (int i = 0; i < 1000000; i++) {
+			__builtin_cpu_init();
+			isa += cpu_has_avx512() ? 2 : cpu_has_avx2();
+		}
+	});
+
+	TIME_BLOCK("Vector dot3 array of 16 SSE", {
+		for (int i = 0; i < iterations; i++) {
+			vec3_dot3_array_sse(out, a + (i & 1), b, 16);
+		}
+	});
+
+	TIME_BLOCK("Vector dot3 array of 16 inline dispatch", {
+		for (int i = 0; i < iterations; i++) {
+			vec3_dot3_array(out, a + (i & 1), b, 16);
+		}
+	});
+
+	TIME_BLOCK("Vector dot3 array of 16 library dispatch", {
+		for (int i = 0; i < iterations; i++) {
+			quemath_vec3_dot3_array(out, a + (i & 1), b, 16);
+		}
+	});
+
+	TIME_BLOCK("Vector normalize array of 16 inline dispatch", {
+		for (int i = 0; i < iterations; i++) {
+			vec3_normalize_array(a, a, 16);
+		}
+	});
+
+	TIME_BLOCK("Vector normalize array of 16 library dispatch", {
+		for (int i = 0; i < iterations; i++) {
+			quemath_vec3_normalize_array(a, a, 16);
+		}
+	});
+
+#endif
+} END_TEST
+
+START_TEST(_mat_multiply) {
+
+	const int iterations = 1000000;
+	mat *m = calloc(iterations, sizeof(mat));
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (int i = 0; i < iterations; i++) {
+		m[i].a = rand = vec_random(rand);
+		m[i].b = rand = vec_random(rand);
+		m[i].c = rand = vec_random(rand);
+		m[i].d = rand = vec_random(rand);
+	}
+
+	TIME_BLOCK("Matrix multiply", {
+		for (int i = 0; i < iterations - 1; i++) {
+			float out[4][4];
+			Matrix4x4_Concat(out, (const float (*)[4]) &m[i], (const float (*)[4]) &m[i + 1]);
+			memcpy(&m[i], out, sizeof(out));
+		}
+	});
+
+	TIME_BLOCK("Matrix multiply SSE", {
+		for (int i = 0; i < iterations - 1; i++) {
+			m[i] = mat_multiply(m[i], m[i + 1]);
+		}
+	});
+
+	TIME_BLOCK("Matrix inverse SSE", {
+		for (int i = 0; i < iterations; i++) {
+			m[i] = mat_inverse(m[i]);
+		}
+	});
+
+	free(m);
+
+	affine *a = calloc(iterations, sizeof(affine));
+	for (int i = 0; i < iterations; i++) {
+		a[i] = affine_convert_mat(mat_multiply(mat_translate(rand), mat_rotate(rand, vec_x(rand))));
+		rand = vec_random(rand);
+	}
+
+	TIME_BLOCK("Affine multiply SSE", {
+		for (int i = 0; i < iterations - 1; i++) {
+			a[i] = affine_multiply(a[i], a[i + 1]);
+		}
+	});
+
+	TIME_BLOCK("Affine inverse SSE", {
+		for (int i = 0; i < iterations; i++) {
+			a[i] = affine_inverse(a[i]);
+		}
+	});
+
+	TIME_BLOCK("Affine inverse rigid SSE", {
+		for (int i = 0; i < iterations; i++) {
+			a[i] = affine_inverse_rigid(a[i]);
+		}
+	});
+
+	free(a);
+
+} END_TEST
+
+static void Matrix4x4_TransformPoint(const float m[4][4], const float *in, float *out) {
+	out[0] = m[0][0] * in[0] + m[1][0] * in[1] + m[2][0] * in[2] + m[3][0];
+	out[1] = m[0][1] * in[0] + m[1][1] * in[1] + m[2][1] * in[2] + m[3][1];
+	out[2] = m[0][2] * in[0] + m[1][2] * in[1] + m[2][2] * in[2] + m[3][2];
+	out[3] = m[0][3] * in[0] + m[1][3] * in[1] + m[2][3] * in[2] + m[3][3];
+}
+
+START_TEST(_mat_transform_points) {
+
+	const int iterations = 10000000;
+	vec *v = random_vectors(iterations);
+	vec *out = vectors(iterations);
+	memset(out, 0xff, iterations * sizeof(vec));
+
+	vec3 *v3 = calloc(iterations, sizeof(vec3));
+	for (int i = 0; i < iterations; i++) {
+		v3[i] = vec_vec3(v[i]);
+	}
+
+	const mat m = mat_multiply(mat_translate(vec3f(1, 2, 3)), mat_rotate(vec3f(1, 1, 0), 1));
+
+	const double bytes3 = iterations * (double) (sizeof(vec3) + sizeof(vec4));
+	const double bytes4 = iterations * (double) (sizeof(vec4) + sizeof(vec4));
+
+	TIME_BLOCK_BYTES("Matrix transform points", bytes3, {
+		for (int i = 0; i < iterations; i++) {
+			Matrix4x4_TransformPoint((const float (*)[4]) &m, v3[i].v, (float *) &out[i]);
+		}
+	});
+
+	TIME_BLOCK_BYTES("Matrix transform points per vertex SSE", bytes3, {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = mat_transform_point(m, vec3fv(v3[i]));
+		}
+	});
+
+	TIME_BLOCK_BYTES("Matrix transform points vec3 SSE", bytes3, {
+		mat_transform_points(m, (vec4 *) out, v3, sizeof(vec3), iterations, 0);
+	});
+
+	TIME_BLOCK_BYTES("Matrix transform points vec3 streaming SSE", bytes3, {
+		mat_transform_points(m, (vec4 *) out, v3, sizeof(vec3), iterations, MAT_TRANSFORM_STREAM);
+	});
+
+	TIME_BLOCK_BYTES("Matrix transform points vec4 SSE", bytes4, {
+		mat_transform_points(m, (vec4 *) out, v, sizeof(vec4), iterations, 0);
+	});
+
+	TIME_BLOCK_BYTES("Matrix transform points vec4 streaming SSE", bytes4, {
+		mat_transform_points(m, (vec4 *) out, v, sizeof(vec4), iterations, MAT_TRANSFORM_STREAM);
+	});
+
+	free(v3);
+	free(out);
+	free(v);
+
+} END_TEST
+
+static vec QuaternionMultiply(const float *a, const float *b) {
+	return vec4f(
+		a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+		a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+		a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3],
+		a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2]
+	);
+}
+
+/**
+ * @return The number of write system calls made by this process, or -1 if unavailable.
+ */
+static long write_syscalls(void) {
+	long syscw = -1;
+
+#if defined(__linux__)
+	FILE *file = fopen("/proc/self/io", "r");
+	if (file) {
+		char line[64];
+		while (fgets(line, sizeof(line), file)) {
+			if (sscanf(line, "syscw: %ld", &syscw) == 1) {
+				break;
+			}
+		}
+		fclose(file);
+	}
+#endif
+
+	return syscw;
+}
+
+START_TEST(_quat_normalize) {
+
+	const int iterations = 10000000;
+	quat *q = random_vectors(iterations);
+	quat *out = vectors(iterations);
+
+	fflush(stdout);
+	const long syscw = write_syscalls();
+
+	TIME_BLOCK("Quaternion normalize SSE", {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = quat_normalize(q[i]);
+		}
+	});
+
+	TIME_BLOCK("Quaternion normalize fast SSE", {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = quat_normalize_fast(q[i]);
+		}
+	});
+
+	TIME_BLOCK("Quaternion normalize array SSE", {
+		quat_normalize_array(out, q, iterations);
+	});
+
+	TIME_BLOCK("Quaternion normalize fast array SSE", {
+		quat_normalize_fast_array(out, q, iterations);
+	});
+
+	// only the four timing lines may be written; normalization itself must perform no I/O
+	fflush(stdout);
+	if (syscw != -1) {
+		ck_assert_int_le(write_syscalls() - syscw, 4);
+	}
+
+	free(q);
+	free(out);
+
+} END_TEST
+
+START_TEST(_mat_convert_quat) {
+
+	const int iterations = 1000000;
+	quat *q = random_vectors(iterations);
+	vec *t = random_vectors(iterations);
+	vec4 *out = calloc(iterations * 4, sizeof(vec4));
+	mat *m = calloc(iterations, sizeof(mat));
+
+	for (int i = 0; i < iterations; i++) {
+		q[i] = quat_normalize(q[i]);
+	}
+
+	memset(out, 0, iterations * 4 * sizeof(vec4));
+	memset(m, 0, iterations * sizeof(mat));
+
+	TIME_BLOCK("Quaternion to matrix SSE", {
+		for (int i = 0; i < iterations; i++) {
+			m[i] = mat_multiply(mat_translate(t[i]), mat_convert_quat(q[i]));
+		}
+	});
+
+	TIME_BLOCK("Quaternion to matrix array SSE", {
+		mat_convert_quat_array(out, q, t, iterations);
+	});
+
+	TIME_BLOCK("Quaternion to affine array SSE", {
+		affine_convert_quat_array(out, q, t, iterations);
+	});
+
+	TIME_BLOCK("Matrix to quaternion SSE", {
+		for (int i = 0; i < iterations; i++) {
+			q[i] = quat_convert_mat(m[i]);
+		}
+	});
+
+	TIME_BLOCK("Matrix to quaternion array SSE", {
+		quat_convert_mat_array(q, m, iterations);
+	});
+
+	free(q);
+	free(t);
+	free(out);
+	free(m);
+
+} END_TEST
+
+START_TEST(_quat_slerp) {
+
+	const int iterations = 10000000;
+	quat *a = random_vectors(iterations);
+	quat *b = random_vectors(iterations);
+	quat *out = vectors(iterations);
+	float *t = calloc(iterations, sizeof(float));
+
+	for (int i = 0; i < iterations; i++) {
+		a[i] = quat_normalize(a[i]);
+		b[i] = quat_normalize(b[i]);
+		t[i] = (i % 1000) / 1000.f;
+	}
+
+	TIME_BLOCK("Quaternion slerp SSE", {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = quat_slerp(a[i], b[i], t[i]);
+		}
+	});
+
+	TIME_BLOCK("Quaternion slerp array SSE", {
+		quat_slerp_array(out, a, b, t, iterations);
+	});
+
+	TIME_BLOCK("Quaternion nlerp SSE", {
+		for (int i = 0; i < iterations; i++) {
+			out[i] = quat_nlerp(a[i], b[i], t[i]);
+		}
+	});
+
+	TIME_BLOCK("Quaternion nlerp array SSE", {
+		quat_nlerp_array(out, a, b, t, iterations);
+	});
+
+	free(a);
+	free(b);
+	free(out);
+	free(t);
+
+} END_TEST
+
+START_TEST(_dquat_skin_array) {
+
+	const int bone_count = 64;
+	const int iterations = 1000000;
+
+	dquat *bones = calloc(bone_count, sizeof(dquat));
+	for (int i = 0; i < bone_count; i++) {
+		bones[i] = dquat_new(quat_euler(vec3f(i, i * .5, -i)), vec3f(i, 1, -i));
+	}
+
+	vec3 *points = calloc(iterations, sizeof(vec3));
+	vec3 *out = calloc(iterations, sizeof(vec3));
+	uint16_t *indices = calloc(iterations * 4, sizeof(uint16_t));
+	vec4 *weights = calloc(iterations, sizeof(vec4));
+
+	for (int i = 0; i < iterations; i++) {
+		points[i] = (vec3) { .v = { i % 100, i % 33, i % 7 } };
+		for (int j = 0; j < 4; j++) {
+			indices[i * 4 + j] = (i + j * 7) % bone_count;
+		}
+		weights[i] = (vec4) { .v = { .4, .3, .2, .1 } };
+	}
+
+	TIME_BLOCK("Dual quaternion skinning SSE", {
+		for (int i = 0; i < iterations; i++) {
+			const dquat dq = dquat_blend(bones, indices + i * 4, weights[i]);
+			out[i] = vec_vec3(dquat_transform_point(dq, vec3fv(points[i])));
+		}
+	});
+
+	TIME_BLOCK("Dual quaternion skinning array SSE", {
+		dquat_skin_array(out, points, indices, weights, bones, iterations);
+	});
+
+	free(bones);
+	free(points);
+	free(out);
+	free(indices);
+	free(weights);
+
+} END_TEST
+
+START_TEST(_quat_compress) {
+
+	const int iterations = 10000000;
+	quat *q = random_vectors(iterations);
+	quat *out = vectors(iterations);
+
+	quat32 *p32 = calloc(iterations, sizeof(quat32));
+	quat48 *p48 = calloc(iterations, sizeof(quat48));
+	quat64 *p64 = calloc(iterations, sizeof(quat64));
+
+	for (int i = 0; i < iterations; i++) {
+		q[i] = quat_normalize(q[i]);
+	}
+
+	memset(out, 0, iterations * sizeof(quat));
+	memset(p32, 0, iterations * sizeof(quat32));
+	memset(p48, 0, iterations * sizeof(quat48));
+	memset(p64, 0, iterations * sizeof(quat64));
+
+	TIME_BLOCK_BYTES("Quaternion compress 32 SSE", iterations * (sizeof(quat) + sizeof(quat32)), {
+		quat32_convert_quat_array(p32, q, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Quaternion decompress 32 SSE", iterations * (sizeof(quat) + sizeof(quat32)), {
+		quat_convert_quat32_array(out, p32, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Quaternion compress 48 SSE", iterations * (sizeof(quat) + sizeof(quat48)), {
+		quat48_convert_quat_array(p48, q, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Quaternion decompress 48 SSE", iterations * (sizeof(quat) + sizeof(quat48)), {
+		quat_convert_quat48_array(out, p48, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Quaternion compress 64 SSE", iterations * (sizeof(quat) + sizeof(quat64)), {
+		quat64_convert_quat_array(p64, q, iterations);
+	});
+
+	TIME_BLOCK_BYTES("Quaternion decompress 64 SSE", iterations * (sizeof(quat) + sizeof(quat64)), {
+		quat_convert_quat64_array(out, p64, iterations);
+	});
+
+	free(q);
+	free(out);
+	free(p32);
+	free(p48);
+	free(p64);
+
+} END_TEST
+
+START_TEST(_quat_multiply) {
+
+	const int iterations = 10000000;
+	vec *v = random_vectors(iterations);
+
+	TIME_BLOCK("Quaternion multiply", {
+		for (int i = 0; i < iterations - 1; i++) {
+			v[i] = QuaternionMultiply((float *) &v[i], (float *) &v[i + 1]);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Quaternion multiply SSE", {
+		for (int i = 0; i < iterations - 1; i++) {
+			v[i] = quat_multiply(v[i], v[i + 1]);
+		}
+	});
+
+	free(v);
+	v = random_vectors(iterations);
+
+	TIME_BLOCK("Quaternion rotate SSE", {
+		for (int i = 0; i < iterations - 1; i++) {
+			v[i] = quat_rotate(v[i + 1], v[i]);
+		}
+	});
+
+	free(v);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+#if QUEMATH_HAS_FMA
+	if (!__builtin_cpu_supports("fma")) {
+		puts("Skipping FMA benchmark, the CPU does not support FMA");
+		return 77;
+	}
+#endif
 
 	TCase *tcase = tcase_create("vec");
 
 	tcase_add_test(tcase, _vec_add);
+	tcase_add_test(tcase, _vec_atan2f);
 	tcase_add_test(tcase, _vec_dot);
 	tcase_add_test(tcase, _vec_normalize);
+	tcase_add_test(tcase, _vec_rsqrt);
 	tcase_add_test(tcase, _vec_scale_add);
+	tcase_add_test(tcase, _vec_sinf);
+	tcase_add_test(tcase, _vec_convert_half);
+	tcase_add_test(tcase, _vec_convert_oct);
+	tcase_add_test(tcase, _vec_convert_dvec);
+	tcase_add_test(tcase, _random_fill);
+	tcase_add_test(tcase, _random_range);
+	tcase_add_test(tcase, _ivec_divide);
+	tcase_add_test(tcase, _library_dispatch);
+	tcase_add_test(tcase, _mat_multiply);
+	tcase_add_test(tcase, _mat_transform_points);
+	tcase_add_test(tcase, _mat_convert_quat);
+	tcase_add_test(tcase, _dquat_skin_array);
+	tcase_add_test(tcase, _quat_compress);
+	tcase_add_test(tcase, _quat_multiply);
+	tcase_add_test(tcase, _quat_normalize);
+	tcase_add_test(tcase, _quat_slerp);
 
 	Suite *suite = suite_create("benchmark");
 	suite_add_tcase(suite, tcase);
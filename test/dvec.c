@@ -0,0 +1,244 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdio.h>
+
+#include "dvec.h"
+
+static inline void assert_dvec_eq(const dvec a, const dvec b) {
+	ck_assert_msg(dvec_equal(a, b), "(%g, %g, %g, %g) == (%g, %g, %g, %g)",
+				  dvec_x(a), dvec_y(a), dvec_z(a), dvec_w(a),
+				  dvec_x(b), dvec_y(b), dvec_z(b), dvec_w(b));
+}
+
+static inline void assert_vec_eq(const vec a, const vec b) {
+	ck_assert_msg(vec_equal(a, b), "(%g, %g, %g, %g) == (%g, %g, %g, %g)",
+				  vec_x(a), vec_y(a), vec_z(a), vec_w(a),
+				  vec_x(b), vec_y(b), vec_z(b), vec_w(b));
+}
+
+#define BATCH_COUNT 11
+
+START_TEST(_dvec0) {
+	assert_dvec_eq(dvec4f(0, 0, 0, 0), dvec0());
+} END_TEST
+
+START_TEST(_dvec3f) {
+	assert_dvec_eq(dvec4f(1, 2, 3, 0), dvec3f(1, 2, 3));
+} END_TEST
+
+START_TEST(_dvec3fv) {
+	assert_dvec_eq(dvec4f(1, 2, 3, 0), dvec3fv((dvec3) { .v = { 1, 2, 3 } }));
+} END_TEST
+
+START_TEST(_dvec4f) {
+	const dvec4 d = dvec_dvec4(dvec4f(1, 2, 3, 4));
+	ck_assert(d.x == 1 && d.y == 2 && d.z == 3 && d.w == 4);
+} END_TEST
+
+START_TEST(_dvec4fv) {
+	assert_dvec_eq(dvec4f(1, 2, 3, 4), dvec4fv((dvec4) { .v = { 1, 2, 3, 4 } }));
+} END_TEST
+
+START_TEST(_vec3_convert_dvec3_relative_array) {
+	dvec3 in[BATCH_COUNT];
+	vec3 out[BATCH_COUNT], out_sse[BATCH_COUNT];
+
+	const dvec3 origin = { .v = { 1e7, -2e7, 3e9 } };
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		in[i] = (dvec3) { .v = { origin.x + i * 0.001, origin.y - i * 0.25, origin.z + i * 1e-6 } };
+	}
+
+	vec3_convert_dvec3_relative_array(out, in, origin, BATCH_COUNT);
+	vec3_convert_dvec3_relative_array_sse(out_sse, in, origin, BATCH_COUNT);
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		const vec v = vec_convert_dvec_relative(dvec3fv(in[i]), dvec3fv(origin));
+		assert_vec_eq(v, vec3fv(out[i]));
+		assert_vec_eq(v, vec3fv(out_sse[i]));
+		ck_assert(fabs(out[i].x - i * 0.001) < 1e-6);
+		ck_assert(out[i].y == -i * 0.25f);
+	}
+} END_TEST
+
+START_TEST(_dvec_add) {
+	assert_dvec_eq(dvec4f(5, 7, 9, 11), dvec_add(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7)));
+} END_TEST
+
+START_TEST(_dvec_convert_vec) {
+	assert_dvec_eq(dvec4f(1, -2, .5, 1e7), dvec_convert_vec(vec4f(1, -2, .5, 1e7)));
+} END_TEST
+
+START_TEST(_dvec_cross) {
+	assert_dvec_eq(dvec3f(-3, 6, -3), dvec_cross(dvec3f(1, 2, 3), dvec3f(4, 5, 6)));
+} END_TEST
+
+START_TEST(_dvec_distance) {
+	assert_dvec_eq(dvec4f(5, 0, 0, 0), dvec_distance(dvec3f(1e9, 1e9, 0), dvec3f(1e9 + 3, 1e9 + 4, 0)));
+} END_TEST
+
+START_TEST(_dvec_divide) {
+	assert_dvec_eq(dvec4f(1, 2, 3, 4), dvec_divide(dvec4f(2, 6, 12, 20), dvec4f(2, 3, 4, 5)));
+} END_TEST
+
+START_TEST(_dvec_dot3) {
+	assert_dvec_eq(dvec4f(32, 0, 0, 0), dvec_dot3(dvec4f(1, 2, 3, 100), dvec4f(4, 5, 6, 100)));
+} END_TEST
+
+START_TEST(_dvec_dot4) {
+	assert_dvec_eq(dvec4f(38, 0, 0, 0), dvec_dot4(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 1.5)));
+} END_TEST
+
+START_TEST(_dvec_dvec3) {
+	const dvec3 d = dvec_dvec3(dvec3f(1, 2, 3));
+	ck_assert(d.x == 1 && d.y == 2 && d.z == 3);
+} END_TEST
+
+START_TEST(_dvec_equal) {
+	ck_assert(dvec_equal(dvec4f(1, 2, 3, 4), dvec4f(1, 2, 3, 4)));
+	ck_assert(!dvec_equal(dvec4f(1, 2, 3, 4), dvec4f(1, 2, 3, 5)));
+	ck_assert(!dvec_equal(dvec4f(1, 2, 3, 4), dvec4f(0, 2, 3, 4)));
+} END_TEST
+
+START_TEST(_dvec_length) {
+	assert_dvec_eq(dvec4f(5, 0, 0, 0), dvec_length(dvec3f(3, 4, 0)));
+} END_TEST
+
+START_TEST(_dvec_max) {
+	assert_dvec_eq(dvec4f(4, 2, 6, 4), dvec_max(dvec4f(1, 2, 3, 4), dvec4f(4, -5, 6, -7)));
+} END_TEST
+
+START_TEST(_dvec_min) {
+	assert_dvec_eq(dvec4f(1, -5, 3, -7), dvec_min(dvec4f(1, 2, 3, 4), dvec4f(4, -5, 6, -7)));
+} END_TEST
+
+START_TEST(_dvec_mix) {
+	assert_dvec_eq(dvec4f(2.5, 3.5, 4.5, 5.5), dvec_mix(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7), .5));
+} END_TEST
+
+START_TEST(_dvec_multiply) {
+	assert_dvec_eq(dvec4f(4, 10, 18, 28), dvec_multiply(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7)));
+} END_TEST
+
+START_TEST(_dvec_multiply_add) {
+	assert_dvec_eq(dvec4f(5, 11, 19, 29), dvec_multiply_add(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7), dvec_new(1)));
+} END_TEST
+
+START_TEST(_dvec_negate) {
+	assert_dvec_eq(dvec4f(-1, 2, -3, 4), dvec_negate(dvec4f(1, -2, 3, -4)));
+} END_TEST
+
+START_TEST(_dvec_new) {
+	assert_dvec_eq(dvec4f(1, 1, 1, 1), dvec_new(1));
+} END_TEST
+
+START_TEST(_dvec_normalize) {
+	assert_dvec_eq(dvec3f(0, 0, -1), dvec_normalize(dvec3f(0, 0, -8)));
+
+	const dvec n = dvec_subtract(dvec3f(.6, .8, 0), dvec_normalize(dvec3f(3e9, 4e9, 0)));
+	ck_assert(dvec_x(dvec_length(n)) < 1e-15);
+} END_TEST
+
+START_TEST(_dvec_scale) {
+	assert_dvec_eq(dvec4f(2, 4, 6, 8), dvec_scale(dvec4f(1, 2, 3, 4), 2));
+} END_TEST
+
+START_TEST(_dvec_scale_add) {
+	assert_dvec_eq(dvec4f(9, 12, 15, 18), dvec_scale_add(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7), 2));
+} END_TEST
+
+START_TEST(_dvec_sqrt) {
+	assert_dvec_eq(dvec4f(1, 2, 3, 4), dvec_sqrt(dvec4f(1, 4, 9, 16)));
+} END_TEST
+
+START_TEST(_dvec_subtract) {
+	assert_dvec_eq(dvec4f(-3, -3, -3, -3), dvec_subtract(dvec4f(1, 2, 3, 4), dvec4f(4, 5, 6, 7)));
+} END_TEST
+
+START_TEST(_dvec_yzx) {
+	assert_dvec_eq(dvec4f(2, 3, 1, 4), dvec_yzx(dvec4f(1, 2, 3, 4)));
+} END_TEST
+
+START_TEST(_dvec_zxy) {
+	assert_dvec_eq(dvec4f(3, 1, 2, 4), dvec_zxy(dvec4f(1, 2, 3, 4)));
+} END_TEST
+
+START_TEST(_vec_convert_dvec) {
+	assert_vec_eq(vec4f(1, -2, .5, 1e7), vec_convert_dvec(dvec4f(1, -2, .5, 1e7)));
+} END_TEST
+
+START_TEST(_vec_convert_dvec_relative) {
+	const dvec origin = dvec3f(1e9, -1e9, 1e12);
+	const vec v = vec_convert_dvec_relative(dvec_add(origin, dvec3f(.125, -.5, 2)), origin);
+	assert_vec_eq(vec3f(.125, -.5, 2), v);
+} END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("dvec");
+	tcase_add_test(tcase, _dvec0);
+	tcase_add_test(tcase, _dvec3f);
+	tcase_add_test(tcase, _dvec3fv);
+	tcase_add_test(tcase, _dvec4f);
+	tcase_add_test(tcase, _dvec4fv);
+	tcase_add_test(tcase, _vec3_convert_dvec3_relative_array);
+	tcase_add_test(tcase, _dvec_add);
+	tcase_add_test(tcase, _dvec_convert_vec);
+	tcase_add_test(tcase, _dvec_cross);
+	tcase_add_test(tcase, _dvec_distance);
+	tcase_add_test(tcase, _dvec_divide);
+	tcase_add_test(tcase, _dvec_dot3);
+	tcase_add_test(tcase, _dvec_dot4);
+	tcase_add_test(tcase, _dvec_dvec3);
+	tcase_add_test(tcase, _dvec_equal);
+	tcase_add_test(tcase, _dvec_length);
+	tcase_add_test(tcase, _dvec_max);
+	tcase_add_test(tcase, _dvec_min);
+	tcase_add_test(tcase, _dvec_mix);
+	tcase_add_test(tcase, _dvec_multiply);
+	tcase_add_test(tcase, _dvec_multiply_add);
+	tcase_add_test(tcase, _dvec_negate);
+	tcase_add_test(tcase, _dvec_new);
+	tcase_add_test(tcase, _dvec_normalize);
+	tcase_add_test(tcase, _dvec_scale);
+	tcase_add_test(tcase, _dvec_scale_add);
+	tcase_add_test(tcase, _dvec_sqrt);
+	tcase_add_test(tcase, _dvec_subtract);
+	tcase_add_test(tcase, _dvec_yzx);
+	tcase_add_test(tcase, _dvec_zxy);
+	tcase_add_test(tcase, _vec_convert_dvec);
+	tcase_add_test(tcase, _vec_convert_dvec_relative);
+
+	Suite *suite = suite_create("dvec");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
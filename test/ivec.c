@@ -60,24 +60,160 @@ START_TEST(_ivec_add) {
 	assert_ivec_eq(ivec3i(2, 4, 6), ivec_add(ivec3i(1, 2, 3), ivec3i(1, 2, 3)));
 } END_TEST
 
+static const int32_t divisors[] = {
+	1, -1, 2, -2, 3, -3, 7, -7, 16, -16, 24, -24, 641, -641, 65537, 1000000007, -1000000007,
+	1 << 30, 3 << 29, INT32_MAX, INT32_MIN, INT32_MIN + 1
+};
+
+static ivec dividends(uint32_t *seed, int i, int32_t d, int32_t n[4]) {
+	static const int32_t edges[] = { 0, 1, -1, 123, -123, INT32_MAX, INT32_MIN, INT32_MIN + 1 };
+
+	for (int j = 0; j < 4; j++) {
+		*seed = *seed * 1664525 + 1013904223;
+		if (i < 2) {
+			n[j] = edges[i * 4 + j];
+		} else if (i < 4) {
+			n[j] = (i & 1 ? d : -d) + j - 2;
+		} else {
+			n[j] = (int32_t) *seed >> (*seed >> 27);
+		}
+	}
+
+	return ivec4iv(n);
+}
+
+START_TEST(_ivec_and) {
+	assert_ivec_eq(ivec4i(0x0f, 0, 1, 0), ivec_and(ivec4i(0xff, 0xf0, 1, -1), ivec4i(0x0f, 0x0f, -1, 0)));
+	assert_ivec_eq(ivec4i(0xf0, 0xf0, 0, -1), ivec_andnot(ivec4i(0x0f, 0x0f, -1, 0), ivec4i(0xff, 0xf0, 1, -1)));
+	assert_ivec_eq(ivec4i(0xff, 0xff, -1, -1), ivec_or(ivec4i(0xff, 0xf0, 1, -1), ivec4i(0x0f, 0x0f, -1, 0)));
+	assert_ivec_eq(ivec4i(0xf0, 0xff, -2, -1), ivec_xor(ivec4i(0xff, 0xf0, 1, -1), ivec4i(0x0f, 0x0f, -1, 0)));
+} END_TEST
+
+START_TEST(_ivec_blend) {
+	const ivec a = ivec4i(1, 2, 3, 4), b = ivec4i(5, 6, 7, 8);
+	assert_ivec_eq(ivec4i(1, 6, 3, 8), ivec_blend(a, b, ivec4i(0, -1, 0, -1)));
+	assert_ivec_eq(ivec4i(5, 6, 3, 4), ivec_blend(a, b, ivec_compare_lt(a, ivec_new(3))));
+} END_TEST
+
+START_TEST(_ivec_divide) {
+	uint32_t seed = 1;
+	for (size_t k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+		const int32_t d = divisors[k];
+		const ivec_divisor divisor = ivec_divisor_new(d);
+
+		for (int i = 0; i < 10000; i++) {
+			int32_t n[4];
+			const ivec a = dividends(&seed, i, d, n);
+
+			int32_t q[4], r[4];
+			_mm_storeu_si128((__m128i *) q, ivec_divide(a, divisor));
+			_mm_storeu_si128((__m128i *) r, ivec_remainder(a, divisor));
+
+			for (int j = 0; j < 4; j++) {
+				if (d == -1) {
+					ck_assert_int_eq((int32_t) (0u - (uint32_t) n[j]), q[j]);
+					ck_assert_int_eq(0, r[j]);
+				} else {
+					ck_assert_int_eq(n[j] / d, q[j]);
+					ck_assert_int_eq(n[j] % d, r[j]);
+				}
+			}
+		}
+	}
+} END_TEST
+
+START_TEST(_ivec_divide_unsigned) {
+	uint32_t seed = 2;
+	for (size_t k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+		const uint32_t d = (uint32_t) divisors[k];
+		const ivec_divisor_unsigned divisor = ivec_divisor_unsigned_new(d);
+
+		for (int i = 0; i < 10000; i++) {
+			uint32_t n[4];
+			const ivec a = dividends(&seed, i, (int32_t) d, (int32_t *) n);
+
+			uint32_t q[4], r[4];
+			_mm_storeu_si128((__m128i *) q, ivec_divide_unsigned(a, divisor));
+			_mm_storeu_si128((__m128i *) r, ivec_remainder_unsigned(a, divisor));
+
+			for (int j = 0; j < 4; j++) {
+				ck_assert_uint_eq(n[j] / d, q[j]);
+				ck_assert_uint_eq(n[j] % d, r[j]);
+			}
+		}
+	}
+} END_TEST
+
 START_TEST(_ivec_equals) {
 	ck_assert_int_eq(1, ivec_equals(ivec_new(1), ivec_new(1)));
 	ck_assert_int_eq(1, ivec_equals(ivec3i(1, 2, 3), ivec3i(1, 2, 3)));
 	ck_assert_int_eq(0, ivec_equals(ivec_new(1), ivec_new(2)));
 } END_TEST
 
+START_TEST(_ivec_floor_divide) {
+	const ivec_divisor sixteen = ivec_divisor_new(16);
+	assert_ivec_eq(ivec4i(-1, -1, 0, 1), ivec_floor_divide(ivec4i(-1, -16, 15, 16), sixteen));
+	assert_ivec_eq(ivec4i(15, 0, 15, 0), ivec_floor_modulo(ivec4i(-1, -16, 15, 16), sixteen));
+
+	uint32_t seed = 3;
+	for (size_t k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+		const int32_t d = divisors[k];
+		if (d == -1) {
+			continue;
+		}
+
+		const ivec_divisor divisor = ivec_divisor_new(d);
+
+		for (int i = 0; i < 10000; i++) {
+			int32_t n[4];
+			const ivec a = dividends(&seed, i, d, n);
+
+			int32_t q[4], m[4];
+			_mm_storeu_si128((__m128i *) q, ivec_floor_divide(a, divisor));
+			_mm_storeu_si128((__m128i *) m, ivec_floor_modulo(a, divisor));
+
+			for (int j = 0; j < 4; j++) {
+				int32_t eq = n[j] / d, em = n[j] % d;
+				if (em && (em ^ d) < 0) {
+					eq -= 1;
+					em += d;
+				}
+				ck_assert_int_eq(eq, q[j]);
+				ck_assert_int_eq(em, m[j]);
+			}
+		}
+	}
+} END_TEST
+
 START_TEST(_ivec_greater_than) {
 	ck_assert_int_eq(1, ivec_greater_than(ivec_new(1), ivec_new(0)));
 	ck_assert_int_eq(0, ivec_greater_than(ivec_new(0), ivec_new(1)));
 	ck_assert_int_eq(0, ivec_greater_than(ivec_new(0), ivec_new(0)));
 } END_TEST
 
+START_TEST(_ivec_horizontal_max) {
+	assert_ivec_eq(ivec_new(7), ivec_horizontal_max(ivec4i(-1, 7, 3, 2)));
+	assert_ivec_eq(ivec_new(-1), ivec_horizontal_max(ivec4i(-1, -7, INT32_MIN, -2)));
+	assert_ivec_eq(ivec_new(-7), ivec_horizontal_min(ivec4i(-1, -7, 3, 2)));
+	assert_ivec_eq(ivec_new(INT32_MIN), ivec_horizontal_min(ivec4i(-1, 7, 3, INT32_MIN)));
+} END_TEST
+
 START_TEST(_ivec_less_than) {
 	ck_assert_int_eq(1, ivec_less_than(ivec_new(0), ivec_new(1)));
 	ck_assert_int_eq(0, ivec_less_than(ivec_new(1), ivec_new(0)));
 	ck_assert_int_eq(0, ivec_less_than(ivec_new(0), ivec_new(0)));
 } END_TEST
 
+START_TEST(_ivec_multiply) {
+	assert_ivec_eq(ivec4i(6, -12, 1 << 30, (int) (0x9abcdef0u * 3)), ivec_multiply(ivec4i(2, 3, 1 << 15, (int) 0x9abcdef0u), ivec4i(3, -4, 1 << 15, 3)));
+	assert_ivec_eq(ivec4i(0, -1, 1, -1), ivec_multiply_high(ivec4i(1, -1, 0x10000, INT32_MIN), ivec4i(1, 1, 0x10000, 2)));
+} END_TEST
+
+START_TEST(_ivec_multiply_high_unsigned) {
+	assert_ivec_eq(ivec4i(0, 1, 0x7fffffff, -2),
+				   ivec_multiply_high_unsigned(ivec4i(1, 0x10000, 0x80000000, -1), ivec4i(-1, 0x10000, -1, -1)));
+} END_TEST
+
 START_TEST(_ivec_random) {
 
 	ivec min = ivec_new(RAND_MAX), max = ivec_new(0);
@@ -124,6 +260,35 @@ START_TEST(_ivec_random_range) {
 
 } END_TEST
 
+START_TEST(_ivec_shift_left) {
+	assert_ivec_eq(ivec4i(2, -2, INT32_MIN, 0), ivec_shift_left(ivec4i(1, -1, 0x40000000, 0), 1));
+	assert_ivec_eq(ivec0(), ivec_shift_left(ivec4i(1, -1, 3, 4), 32));
+	assert_ivec_eq(ivec4i(-1, 0x1fffffff, -4, 3), ivec_shift_right(ivec4i(-1, INT32_MAX, -16, 15), 2));
+	assert_ivec_eq(ivec4i(0x3fffffff, 0x1fffffff, 0x3ffffffc, 3), ivec_shift_right_logical(ivec4i(-1, INT32_MAX, -16, 15), 2));
+
+	const int32_t values[] = { 1, -1, INT32_MIN, INT32_MAX, 0x12345678, -0x12345678, 3, -3 };
+	for (int i = 0; i < 8; i++) {
+		for (int bits = 0; bits < 40; bits += 3) {
+			const ivec v = ivec4i(values[i], values[(i + 1) % 8], values[(i + 2) % 8], values[(i + 3) % 8]);
+			const ivec b = ivec4i(bits, (bits + 1) % 40, (bits + 2) % 40, 31);
+
+			int32_t in[4], counts[4], left[4], right[4], logical[4];
+			_mm_storeu_si128((__m128i *) in, v);
+			_mm_storeu_si128((__m128i *) counts, b);
+			_mm_storeu_si128((__m128i *) left, ivec_shift_left_variable(v, b));
+			_mm_storeu_si128((__m128i *) right, ivec_shift_right_variable(v, b));
+			_mm_storeu_si128((__m128i *) logical, ivec_shift_right_logical_variable(v, b));
+
+			for (int j = 0; j < 4; j++) {
+				const int c = counts[j];
+				ck_assert_int_eq(c > 31 ? 0 : (int32_t) ((uint32_t) in[j] << c), left[j]);
+				ck_assert_int_eq(c > 31 ? in[j] >> 31 : in[j] >> c, right[j]);
+				ck_assert_int_eq(c > 31 ? 0 : (int32_t) ((uint32_t) in[j] >> c), logical[j]);
+			}
+		}
+	}
+} END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("ivec");
@@ -135,11 +300,20 @@ int main(int argc, char **argv) {
 	tcase_add_test(tcase, _ivec4i);
 	tcase_add_test(tcase, _ivec_abs);
 	tcase_add_test(tcase, _ivec_add);
+	tcase_add_test(tcase, _ivec_and);
+	tcase_add_test(tcase, _ivec_blend);
+	tcase_add_test(tcase, _ivec_divide);
+	tcase_add_test(tcase, _ivec_divide_unsigned);
 	tcase_add_test(tcase, _ivec_equals);
+	tcase_add_test(tcase, _ivec_floor_divide);
 	tcase_add_test(tcase, _ivec_greater_than);
+	tcase_add_test(tcase, _ivec_horizontal_max);
 	tcase_add_test(tcase, _ivec_less_than);
+	tcase_add_test(tcase, _ivec_multiply);
+	tcase_add_test(tcase, _ivec_multiply_high_unsigned);
 	tcase_add_test(tcase, _ivec_random);
 	tcase_add_test(tcase, _ivec_random_range);
+	tcase_add_test(tcase, _ivec_shift_left);
 
 	Suite *suite = suite_create("ivec");
 	suite_add_tcase(suite, tcase);
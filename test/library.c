@@ -0,0 +1,146 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "library.h"
+
+#define WIDE_COUNT 45
+
+static void random_vec3s(vec3 *out, size_t count) {
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (size_t i = 0; i < count; i++) {
+		rand = vec_random(rand);
+		out[i] = vec_vec3(vec_subtract(vec_scale(rand, 20), vec_new(10)));
+	}
+}
+
+START_TEST(_quemath_isa) {
+	const char *isa = quemath_isa();
+
+	if (cpu_has_avx512()) {
+		ck_assert(strcmp("avx512", isa) == 0);
+	} else if (cpu_has_avx2()) {
+		ck_assert(strcmp("avx2", isa) == 0);
+	} else {
+		ck_assert(strcmp("sse4.1", isa) == 0);
+	}
+} END_TEST
+
+START_TEST(_quemath_vec3_array) {
+	vec3 a[WIDE_COUNT], b[WIDE_COUNT], expected[WIDE_COUNT], out[WIDE_COUNT];
+	float expected_f[WIDE_COUNT], f[WIDE_COUNT];
+
+	random_vec3s(a, WIDE_COUNT);
+	random_vec3s(b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		b[i] = vec_vec3(vec_yzx(vec3fv(b[i])));
+	}
+
+	// the library binds the same kernels the inline dispatch selects, and every kernel is bit exact
+	// with the SSE kernel, so results do not vary with the CPU the library is loaded on
+	for (size_t count = 0; count <= WIDE_COUNT; count++) {
+		memset(out, 0, sizeof(out));
+		memset(expected, 0, sizeof(expected));
+
+		vec3_add_array_sse(expected, a, b, count);
+		quemath_vec3_add_array(out, a, b, count);
+		ck_assert(memcmp(expected, out, sizeof(out)) == 0);
+
+		vec3_cross_array_sse(expected, a, b, count);
+		quemath_vec3_cross_array(out, a, b, count);
+		ck_assert(memcmp(expected, out, sizeof(out)) == 0);
+
+		vec3_normalize_array_sse(expected, a, count);
+		quemath_vec3_normalize_array(out, a, count);
+		ck_assert(memcmp(expected, out, sizeof(out)) == 0);
+
+		vec3_scale_add_array_sse(expected, a, b, 0.5, count);
+		quemath_vec3_scale_add_array(out, a, b, 0.5, count);
+		ck_assert(memcmp(expected, out, sizeof(out)) == 0);
+
+		memset(f, 0, sizeof(f));
+		memset(expected_f, 0, sizeof(expected_f));
+
+		vec3_distance_array_sse(expected_f, a, b, count);
+		quemath_vec3_distance_array(f, a, b, count);
+		ck_assert(memcmp(expected_f, f, sizeof(f)) == 0);
+
+		vec3_dot3_array_sse(expected_f, a, b, count);
+		quemath_vec3_dot3_array(f, a, b, count);
+		ck_assert(memcmp(expected_f, f, sizeof(f)) == 0);
+
+		vec3_length_array_sse(expected_f, a, count);
+		quemath_vec3_length_array(f, a, count);
+		ck_assert(memcmp(expected_f, f, sizeof(f)) == 0);
+	}
+} END_TEST
+
+START_TEST(_quemath_half_array) {
+	float f[WIDE_COUNT], expected_f[WIDE_COUNT], out_f[WIDE_COUNT];
+	half h[WIDE_COUNT], expected_h[WIDE_COUNT];
+
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		f[i] = (i - 20) * 1.37f;
+	}
+
+	for (size_t count = 0; count <= WIDE_COUNT; count++) {
+		memset(h, 0, sizeof(h));
+		memset(expected_h, 0, sizeof(expected_h));
+
+		half_convert_vec_array(expected_h, f, count);
+		quemath_half_convert_vec_array(h, f, count);
+		ck_assert(memcmp(expected_h, h, sizeof(h)) == 0);
+
+		memset(out_f, 0, sizeof(out_f));
+		memset(expected_f, 0, sizeof(expected_f));
+
+		vec_convert_half_array(expected_f, h, count);
+		quemath_vec_convert_half_array(out_f, h, count);
+		ck_assert(memcmp(expected_f, out_f, sizeof(out_f)) == 0);
+	}
+} END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("library");
+
+	tcase_add_test(tcase, _quemath_isa);
+	tcase_add_test(tcase, _quemath_vec3_array);
+	tcase_add_test(tcase, _quemath_half_array);
+
+	Suite *suite = suite_create("library");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
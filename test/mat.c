@@ -22,44 +22,299 @@
  */
 
 #include <check.h>
-#include <math.h>
+#include <stdio.h>
 
-#include <ObjectivelyGL.h>
+#include "mat.h"
 
-#define assert_flt_eq(a, b) ck_assert(fabsf(a - b) < __FLT_EPSILON__)
-#define assert_vec_eq(a, b) \
-{ \
-	assert_flt_eq(a.x, b.x); \
-	assert_flt_eq(a.y, b.y); \
-	assert_flt_eq(a.z, b.z); \
-	assert_flt_eq(a.w, b.w); \
+static inline void assert_vec_eq(const vec a, const vec b, float epsilon) {
+	const vec delta = vec_max(vec_subtract(a, b), vec_subtract(b, a));
+	ck_assert_msg(ivec_equals(vec_compare_le(delta, vec_new(epsilon)), ivec_true()), "(%g, %g, %g, %g) == (%g, %g, %g, %g)",
+				  vec_x(a), vec_y(a), vec_z(a), vec_w(a),
+				  vec_x(b), vec_y(b), vec_z(b), vec_w(b));
 }
 
+static inline void assert_mat_eq(const mat a, const mat b, float epsilon) {
+	assert_vec_eq(a.a, b.a, epsilon);
+	assert_vec_eq(a.b, b.b, epsilon);
+	assert_vec_eq(a.c, b.c, epsilon);
+	assert_vec_eq(a.d, b.d, epsilon);
+}
+
+static mat random_mat(void) {
+	return mat_multiply(mat_translate(vec3f(4, -2, 1)),
+		mat_multiply(mat_rotate(vec3f(1, 2, 3), 1.2), mat_scale(vec3f(2, 3, .5))));
+}
+
+/**
+ * @brief Rotations exercising each branch of quat_convert_mat, including half turns.
+ */
+static const float rotations[][4] = {
+	{ 1, 2, 3, 1.2 },
+	{ 1, 0, 0, 3.1 },
+	{ 0, 1, 0, 3.1 },
+	{ 0, 0, 1, 3.1 },
+	{ 1, 1, 0, M_PI },
+	{ -1, .1, .2, 2.5 },
+	{ .3, -.2, 1, -2.9 },
+	{ 0, 0, 1, 0 },
+	{ 2, -3, 1, -.4 }
+};
+
+#define ROTATION_COUNT (sizeof(rotations) / sizeof(rotations[0]))
+
+static quat rotation(size_t i) {
+	return quat_new(vec3f(rotations[i][0], rotations[i][1], rotations[i][2]), rotations[i][3]);
+}
+
+static inline void assert_quat_rotation_eq(const quat a, const quat b, float epsilon) {
+	const vec sign = _mm_and_ps(_mm_dp_ps(a, b, 0xFF), vec_new(-0.f));
+	assert_vec_eq(a, _mm_xor_ps(b, sign), epsilon);
+}
+
+START_TEST(_affine_convert_mat) {
+	const mat m = random_mat();
+	const affine a = affine_convert_mat(m);
+	assert_mat_eq(m, mat_convert_affine(a), 0);
+	assert_vec_eq(mat_transform_point(m, vec3f(1, 2, 3)), vec_add(affine_transform_point(a, vec3f(1, 2, 3)), vec4f(0, 0, 0, 1)), 0.00001);
+	assert_vec_eq(vec_xyz(mat_transform_direction(m, vec3f(1, 2, 3))), affine_transform_direction(a, vec4f(1, 2, 3, 1)), 0.00001);
+} END_TEST
+
+START_TEST(_affine_convert_quat) {
+	quat q[ROTATION_COUNT];
+	vec t[ROTATION_COUNT];
+	vec4 out[ROTATION_COUNT * 3];
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		q[i] = rotation(i);
+		t[i] = vec3f(i, -2.f * i, .5f);
+	}
+
+	affine_convert_quat_array(out, q, t, ROTATION_COUNT);
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		const affine a = affine_convert_mat(mat_multiply(mat_translate(t[i]), mat_convert_quat(q[i])));
+		assert_vec_eq(a.x, vec4fv(out[i * 3 + 0]), 0.000001);
+		assert_vec_eq(a.y, vec4fv(out[i * 3 + 1]), 0.000001);
+		assert_vec_eq(a.z, vec4fv(out[i * 3 + 2]), 0.000001);
+	}
+
+	affine_convert_quat_array(out, q, NULL, ROTATION_COUNT);
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		const affine a = affine_convert_quat(q[i]);
+		assert_vec_eq(a.x, vec4fv(out[i * 3 + 0]), 0.000001);
+		assert_vec_eq(a.y, vec4fv(out[i * 3 + 1]), 0.000001);
+		assert_vec_eq(a.z, vec4fv(out[i * 3 + 2]), 0.000001);
+	}
+} END_TEST
+
+START_TEST(_affine_inverse) {
+	const affine a = affine_convert_mat(random_mat());
+	assert_mat_eq(mat_inverse(mat_convert_affine(a)), mat_convert_affine(affine_inverse(a)), 0.00001);
+	assert_mat_eq(mat_identity(), mat_convert_affine(affine_multiply(a, affine_inverse(a))), 0.00001);
+} END_TEST
+
+START_TEST(_affine_inverse_rigid) {
+	const affine a = affine_convert_mat(mat_multiply(mat_translate(vec3f(4, -2, 1)), mat_rotate(vec3f(1, 2, 3), 1.2)));
+	assert_mat_eq(mat_convert_affine(affine_inverse(a)), mat_convert_affine(affine_inverse_rigid(a)), 0.00001);
+	assert_mat_eq(mat_identity(), mat_convert_affine(affine_multiply(affine_inverse_rigid(a), a)), 0.00001);
+} END_TEST
+
+START_TEST(_affine_multiply) {
+	const mat a = random_mat();
+	const mat b = mat_multiply(mat_rotate(vec3f(0, 1, 0), 0.3), mat_translate(vec3f(1, 2, 3)));
+	assert_mat_eq(mat_multiply(a, b), mat_convert_affine(affine_multiply(affine_convert_mat(a), affine_convert_mat(b))), 0.00001);
+	assert_mat_eq(mat_identity(), mat_convert_affine(affine_identity()), 0);
+} END_TEST
+
+START_TEST(_mat_convert_quat) {
+	assert_mat_eq(mat_identity(), mat_convert_quat(quat_identity()), 0);
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		const vec axis = vec3f(rotations[i][0], rotations[i][1], rotations[i][2]);
+		assert_mat_eq(mat_rotate(axis, rotations[i][3]), mat_convert_quat(rotation(i)), 0.000002);
+	}
+
+	quat q[ROTATION_COUNT];
+	vec t[ROTATION_COUNT];
+	vec4 out[ROTATION_COUNT * 4];
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		q[i] = rotation(i);
+		t[i] = vec3f(i, -2.f * i, .5f);
+	}
+
+	mat_convert_quat_array(out, q, t, ROTATION_COUNT);
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		const mat m = mat_multiply(mat_translate(t[i]), mat_convert_quat(q[i]));
+		assert_mat_eq(m, (mat) {
+			vec4fv(out[i * 4 + 0]),
+			vec4fv(out[i * 4 + 1]),
+			vec4fv(out[i * 4 + 2]),
+			vec4fv(out[i * 4 + 3])
+		}, 0.000001);
+	}
+} END_TEST
+
+START_TEST(_mat_determinant) {
+	assert_vec_eq(vec_new(1), mat_determinant(mat_identity()), 0);
+	assert_vec_eq(vec_new(3), mat_determinant(mat_scale(vec3f(1, 3, 1))), 0);
+	assert_vec_eq(vec_new(3), mat_determinant(random_mat()), 0.00001);
+
+	const mat m = {
+		vec4f(1, 2, 0, 3),
+		vec4f(0, 1, 4, 1),
+		vec4f(2, 0, 1, 0),
+		vec4f(1, 1, 1, 1)
+	};
+	assert_vec_eq(vec_new(-7), mat_determinant(m), 0.00001);
+} END_TEST
+
 START_TEST(_mat_identity) {
-	mat m = mat_identity();
-	assert_vec_eq(m.a, vec4f(1, 0, 0, 0));
-	assert_vec_eq(m.b, vec4f(0, 1, 0, 0));
-	assert_vec_eq(m.c, vec4f(0, 0, 1, 0));
-	assert_vec_eq(m.d, vec4f(0, 0, 0, 1));
+	const mat m = mat_identity();
+	assert_vec_eq(m.a, vec4f(1, 0, 0, 0), 0);
+	assert_vec_eq(m.b, vec4f(0, 1, 0, 0), 0);
+	assert_vec_eq(m.c, vec4f(0, 0, 1, 0), 0);
+	assert_vec_eq(m.d, vec4f(0, 0, 0, 1), 0);
+} END_TEST
+
+START_TEST(_mat_inverse) {
+	assert_mat_eq(mat_identity(), mat_inverse(mat_identity()), 0);
+	assert_mat_eq(mat_translate(vec3f(-1, -2, -3)), mat_inverse(mat_translate(vec3f(1, 2, 3))), 0);
+
+	const mat m = {
+		vec4f(1, 2, 0, 3),
+		vec4f(0, 1, 4, 1),
+		vec4f(2, 0, 1, 0),
+		vec4f(1, 1, 1, 1)
+	};
+	assert_mat_eq(mat_identity(), mat_multiply(m, mat_inverse(m)), 0.00001);
+	assert_mat_eq(mat_identity(), mat_multiply(mat_inverse(random_mat()), random_mat()), 0.00001);
+} END_TEST
+
+START_TEST(_mat_multiply) {
+	const mat m = random_mat();
+	assert_mat_eq(m, mat_multiply(m, mat_identity()), 0);
+	assert_mat_eq(m, mat_multiply(mat_identity(), m), 0);
+	assert_mat_eq(mat_translate(vec3f(2, 4, 6)), mat_multiply(mat_translate(vec3f(1, 2, 3)), mat_translate(vec3f(1, 2, 3))), 0);
+} END_TEST
+
+START_TEST(_mat_rotate) {
+	assert_mat_eq(mat_identity(), mat_rotate(vec3f(0, 0, 1), 0), 0);
+	assert_vec_eq(vec3f(0, 1, 0), mat_transform_direction(mat_rotate(vec3f(0, 0, 1), M_PI_2), vec3f(1, 0, 0)), 0.000001);
+	assert_vec_eq(vec3f(0, 0, 1), mat_transform_direction(mat_rotate(vec3f(1, 0, 0), M_PI_2), vec3f(0, 1, 0)), 0.000001);
+	assert_vec_eq(vec3f(0, 1, 0), mat_transform_direction(mat_rotate(vec3f(1, 1, 1), 2 * M_PI / 3), vec3f(1, 0, 0)), 0.000001);
+} END_TEST
+
+START_TEST(_mat_scale) {
+	assert_vec_eq(vec4f(2, 6, -3, 1), mat_transform_point(mat_scale(vec3f(2, 3, -1)), vec3f(1, 2, 3)), 0);
+} END_TEST
+
+START_TEST(_mat_transform) {
+	const mat m = random_mat();
+	assert_vec_eq(mat_transform_point(m, vec3f(1, 2, 3)), mat_transform(m, vec4f(1, 2, 3, 1)), 0);
+	assert_vec_eq(mat_transform_direction(m, vec3f(1, 2, 3)), mat_transform(m, vec4f(1, 2, 3, 0)), 0);
+	assert_vec_eq(vec4f(2, 4, 6, 1), mat_transform_point(mat_translate(vec3f(1, 2, 3)), vec4f(1, 2, 3, 0)), 0);
+	assert_vec_eq(vec3f(1, 2, 3), mat_transform_direction(mat_translate(vec3f(1, 2, 3)), vec4f(1, 2, 3, 1)), 0);
+} END_TEST
+
+START_TEST(_mat_transform_points) {
+
+	const int count = 11;
+	vec3 points[count];
+	vec4 points4[count];
+	for (int i = 0; i < count; i++) {
+		points[i] = (vec3) { i, i * 2 - 5, 3 - i };
+		points4[i] = (vec4) { i, i * 2 - 5, 3 - i, 7 };
+	}
+
+	const mat m = random_mat();
+
+	vec out[count];
+	mat_transform_points(m, (vec4 *) out, points, sizeof(vec3), count, 0);
+	for (int i = 0; i < count; i++) {
+		assert_vec_eq(mat_transform_point(m, vec3fv(points[i])), out[i], 0);
+	}
+
+	mat_transform_points(m, (vec4 *) out, points4, sizeof(vec4), count, MAT_TRANSFORM_STREAM);
+	for (int i = 0; i < count; i++) {
+		assert_vec_eq(mat_transform_point(m, vec3fv(points[i])), out[i], 0);
+	}
+
+	mat_transform_directions(m, (vec4 *) out, points, sizeof(vec3), count, MAT_TRANSFORM_STREAM);
+	for (int i = 0; i < count; i++) {
+		assert_vec_eq(mat_transform_direction(m, vec3fv(points[i])), out[i], 0);
+	}
 } END_TEST
 
 START_TEST(_mat_translate) {
-	mat m = mat_translate(1, 2, 3);
-	assert_vec_eq(m.a, vec4f(0, 0, 0, 1));
-	assert_vec_eq(m.b, vec4f(0, 0, 0, 2));
-	assert_vec_eq(m.c, vec4f(0, 0, 0, 3));
-	assert_vec_eq(m.d, vec4f(0, 0, 0, 0));
+	const mat m = mat_translate(vec3f(1, 2, 3));
+	assert_vec_eq(m.a, vec4f(1, 0, 0, 0), 0);
+	assert_vec_eq(m.b, vec4f(0, 1, 0, 0), 0);
+	assert_vec_eq(m.c, vec4f(0, 0, 1, 0), 0);
+	assert_vec_eq(m.d, vec4f(1, 2, 3, 1), 0);
+} END_TEST
+
+START_TEST(_quat_convert_mat) {
+	assert_vec_eq(quat_identity(), quat_convert_mat(mat_identity()), 0);
+
+	mat m[ROTATION_COUNT];
+	quat out[ROTATION_COUNT];
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		assert_quat_rotation_eq(rotation(i), quat_convert_mat(mat_convert_quat(rotation(i))), 0.000001);
 
+		const vec axis = vec3f(rotations[i][0], rotations[i][1], rotations[i][2]);
+		m[i] = mat_multiply(mat_translate(vec3f(1, 2, 3)), mat_rotate(axis, rotations[i][3]));
+	}
+
+	quat_convert_mat_array(out, m, ROTATION_COUNT);
+
+	for (size_t i = 0; i < ROTATION_COUNT; i++) {
+		assert_quat_rotation_eq(rotation(i), out[i], 0.000001);
+		assert_quat_rotation_eq(quat_convert_mat(m[i]), out[i], 0.0000002);
+	}
+} END_TEST
 
+START_TEST(_mat_transpose) {
+	const mat m = {
+		vec4f(0, 1, 2, 3),
+		vec4f(4, 5, 6, 7),
+		vec4f(8, 9, 10, 11),
+		vec4f(12, 13, 14, 15)
+	};
+	const mat t = mat_transpose(m);
+	assert_vec_eq(t.a, vec4f(0, 4, 8, 12), 0);
+	assert_vec_eq(t.b, vec4f(1, 5, 9, 13), 0);
+	assert_vec_eq(t.c, vec4f(2, 6, 10, 14), 0);
+	assert_vec_eq(t.d, vec4f(3, 7, 11, 15), 0);
+	assert_mat_eq(m, mat_transpose(t), 0);
 } END_TEST
 
 int main(int argc, char **argv) {
 
-	TCase *tcase = tcase_create("Matrix");
+	TCase *tcase = tcase_create("mat");
 
+	tcase_add_test(tcase, _affine_convert_mat);
+	tcase_add_test(tcase, _affine_convert_quat);
+	tcase_add_test(tcase, _affine_inverse);
+	tcase_add_test(tcase, _affine_inverse_rigid);
+	tcase_add_test(tcase, _affine_multiply);
+	tcase_add_test(tcase, _mat_convert_quat);
+	tcase_add_test(tcase, _mat_determinant);
 	tcase_add_test(tcase, _mat_identity);
+	tcase_add_test(tcase, _mat_inverse);
+	tcase_add_test(tcase, _mat_multiply);
+	tcase_add_test(tcase, _mat_rotate);
+	tcase_add_test(tcase, _mat_scale);
+	tcase_add_test(tcase, _mat_transform);
+	tcase_add_test(tcase, _mat_transform_points);
+	tcase_add_test(tcase, _mat_translate);
+	tcase_add_test(tcase, _mat_transpose);
+	tcase_add_test(tcase, _quat_convert_mat);
 
-	Suite *suite = suite_create("Matrix");
+	Suite *suite = suite_create("mat");
 	suite_add_tcase(suite, tcase);
 
 	SRunner *runner = srunner_create(suite);
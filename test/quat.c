@@ -32,21 +32,424 @@ static inline void assert_quat_eq(const vec a, const vec b) {
 				  quat_x(b), quat_y(b), quat_z(b), quat_w(b));
 }
 
+static inline void assert_vec_near(const vec a, const vec b, float epsilon) {
+	const vec delta = vec_max(vec_subtract(a, b), vec_subtract(b, a));
+	ck_assert_msg(ivec_equals(vec_compare_le(delta, vec_new(epsilon)), ivec_true()),
+				  "(%g, %g, %g, %g) == (%g, %g, %g, %g)",
+				  vec_x(a), vec_y(a), vec_z(a), vec_w(a),
+				  vec_x(b), vec_y(b), vec_z(b), vec_w(b));
+}
+
+START_TEST(_dquat_new) {
+	const quat r = quat_new(vec3f(1, -2, .5), 1.3);
+	const vec t = vec3f(4, -5, 6);
+	const vec p = vec3f(.3, 2, -7);
+
+	const dquat dq = dquat_new(r, t);
+
+	assert_vec_near(t, dquat_translation(dq), 0.00001);
+	assert_vec_near(vec_add(quat_rotate(r, p), t), dquat_transform_point(dq, p), 0.00001);
+	assert_vec_near(p, dquat_transform_point(dquat_identity(), p), 0);
+} END_TEST
+
+START_TEST(_dquat_multiply) {
+	const dquat a = dquat_new(quat_new(vec3f(1, -2, .5), 1.3), vec3f(4, -5, 6));
+	const dquat b = dquat_new(quat_new(vec3f(0, 1, 1), -.7), vec3f(-1, 2, 0));
+	const vec p = vec3f(.3, 2, -7);
+
+	const vec expected = dquat_transform_point(a, dquat_transform_point(b, p));
+	assert_vec_near(expected, dquat_transform_point(dquat_multiply(a, b), p), 0.00001);
+} END_TEST
+
+START_TEST(_dquat_normalize) {
+	const dquat dq = dquat_new(quat_new(vec3f(1, -2, .5), 1.3), vec3f(4, -5, 6));
+	const dquat scaled = { vec_scale(dq.real, 3), vec_add(vec_scale(dq.dual, 3), vec_scale(dq.real, .1)) };
+
+	const dquat n = dquat_normalize(scaled);
+
+	assert_vec_near(dq.real, n.real, 0.000001);
+	assert_vec_near(dq.dual, n.dual, 0.00001);
+	ck_assert(fabsf(vec_x(_mm_dp_ps(n.real, n.dual, 0xFF))) < 0.000001);
+} END_TEST
+
+START_TEST(_dquat_skin_array) {
+	const dquat bones[3] = {
+		dquat_identity(),
+		dquat_new(quat_new(vec3f(1, 0, 0), 170 * M_PI / 180), vec0()),
+		dquat_new(quat_new(vec3f(0, 1, 1), 2), vec3f(1, 2, 3)),
+	};
+
+	// a single bone is the bone's transform
+	const uint16_t single[4] = { 2, 0, 0, 0 };
+	const dquat blend = dquat_blend(bones, single, (vec4) { .v = { 1, 0, 0, 0 } });
+	assert_vec_near(bones[2].real, blend.real, 0.000001);
+	assert_vec_near(bones[2].dual, blend.dual, 0.000001);
+
+	// an even blend of a nearly opposite twist preserves the distance from the axis
+	const uint16_t twist[4] = { 0, 1, 0, 0 };
+	const vec p = dquat_transform_point(dquat_blend(bones, twist, (vec4) { .v = { .5, .5, 0, 0 } }), vec3f(3, 0, 1));
+	ck_assert(fabsf(sqrtf(vec_y(p) * vec_y(p) + vec_z(p) * vec_z(p)) - 1) < 0.000001);
+	assert_vec_near(vec3f(3, -sinf(85 * M_PI / 180), cosf(85 * M_PI / 180)), p, 0.000001);
+
+	vec3 points[7], out[7];
+	uint16_t indices[7 * 4];
+	vec4 weights[7];
+
+	for (int i = 0; i < 7; i++) {
+		points[i] = (vec3) { .v = { i, -i, 2 * i } };
+		for (int j = 0; j < 4; j++) {
+			indices[i * 4 + j] = (i + j) % 3;
+		}
+		weights[i] = (vec4) { .v = { .25 + i * .05, .5 - i * .05, .15, .1 } };
+	}
+
+	dquat_skin_array(out, points, indices, weights, bones, 7);
+
+	for (int i = 0; i < 7; i++) {
+		const dquat dq = dquat_blend(bones, indices + i * 4, weights[i]);
+		assert_vec_near(dquat_transform_point(dq, vec3fv(points[i])), vec3fv(out[i]), 0.00001);
+	}
+} END_TEST
+
+#define COMPRESS_COUNT 1067
+
+/**
+ * @brief The quantization steps of the compressed quaternions.
+ */
+#define QUAT32_STEP (M_SQRT2 / 1022)
+#define QUAT48_STEP (M_SQRT2 / 32766)
+#define QUAT64_STEP (1. / 32767)
+
+/**
+ * @brief The allowance for single precision rounding, atop the quantization error bounds.
+ */
+#define ROUNDING 2.5e-7
+
+/**
+ * @brief Unit quaternions for compression, including ties and negative largest components.
+ * @details Quaternions near `(½, ½, ½, ½)` with components straddling the quantization
+ * @p midpoint are included, as these incur the greatest error.
+ */
+static quat *compress_quats(double midpoint) {
+	quat *q = calloc(COMPRESS_COUNT, sizeof(quat));
+
+	q[0] = quat_identity();
+	q[1] = quat4f(0, 0, 0, -1);
+	q[2] = quat4f(1, 0, 0, 0);
+	q[3] = quat4f(M_SQRT1_2, M_SQRT1_2, 0, 0);
+	q[4] = quat4f(.5, -.5, .5, -.5);
+	q[5] = quat4f(0, -M_SQRT1_2, 0, M_SQRT1_2);
+
+	const double offsets[4] = { -3e-7, -1e-7, 1e-7, 3e-7 };
+	for (int i = 0; i < 64; i++) {
+		const double x = midpoint + offsets[i & 3];
+		const double y = midpoint + offsets[(i >> 2) & 3];
+		const double z = midpoint + offsets[(i >> 4) & 3];
+		q[6 + i] = quat4f(x, y, z, sqrt(1 - x * x - y * y - z * z));
+	}
+
+	vec r = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (int i = 70; i < COMPRESS_COUNT; i++) {
+		r = vec_random(r);
+		q[i] = quat_normalize(vec_subtract(vec_scale(r, 2), vec_new(1)));
+	}
+
+	return q;
+}
+
+/**
+ * @return The midpoint between the smallest three quantization levels of @p step nearest below `½`.
+ */
+static double smallest_three_midpoint(double step) {
+	return -M_SQRT1_2 + (floor((.5 + M_SQRT1_2) / step - .5) + .5) * step;
+}
+
+static inline void assert_quat_rotation_near(const quat a, const quat b, float epsilon) {
+	const vec sign = _mm_and_ps(_mm_dp_ps(a, b, 0xFF), vec_new(-0.f));
+	assert_vec_near(a, _mm_xor_ps(b, sign), epsilon);
+}
+
+static inline void assert_quat_angle_le(const quat a, const quat b, double radians) {
+	const vec sign = _mm_and_ps(_mm_dp_ps(a, b, 0xFF), vec_new(-0.f));
+	const vec4 delta = vec_vec4(vec_subtract(a, _mm_xor_ps(b, sign)));
+
+	double chord = 0;
+	for (int i = 0; i < 4; i++) {
+		chord += (double) delta.v[i] * delta.v[i];
+	}
+
+	const double angle = 4 * asin(sqrt(chord) / 2);
+	ck_assert_msg(angle <= radians, "%g <= %g", angle, radians);
+}
+
+START_TEST(_quat32_convert_quat) {
+	quat *q = compress_quats(smallest_three_midpoint(QUAT32_STEP));
+	quat32 *p = calloc(COMPRESS_COUNT, sizeof(quat32));
+	quat *out = calloc(COMPRESS_COUNT, sizeof(quat));
+
+	quat32_convert_quat_array(p, q, COMPRESS_COUNT);
+	quat_convert_quat32_array(out, p, COMPRESS_COUNT);
+
+	for (int i = 0; i < COMPRESS_COUNT; i++) {
+		ck_assert_int_eq(quat32_convert_quat(q[i]), p[i]);
+		assert_quat_eq(quat_convert_quat32(p[i]), out[i]);
+		assert_quat_rotation_near(q[i], out[i], 1.5 * QUAT32_STEP + ROUNDING);
+		assert_quat_angle_le(q[i], out[i], 2 * sqrt(3) * QUAT32_STEP + ROUNDING);
+	}
+
+	assert_quat_eq(quat_identity(), quat_convert_quat32(quat32_convert_quat(quat4f(0, 0, 0, -1))));
+
+	free(q);
+	free(p);
+	free(out);
+} END_TEST
+
+START_TEST(_quat48_convert_quat) {
+	quat *q = compress_quats(smallest_three_midpoint(QUAT48_STEP));
+	quat48 *p = calloc(COMPRESS_COUNT, sizeof(quat48));
+	quat *out = calloc(COMPRESS_COUNT, sizeof(quat));
+
+	quat48_convert_quat_array(p, q, COMPRESS_COUNT);
+	quat_convert_quat48_array(out, p, COMPRESS_COUNT);
+
+	for (int i = 0; i < COMPRESS_COUNT; i++) {
+		const quat48 s = quat48_convert_quat(q[i]);
+		ck_assert(s.v[0] == p[i].v[0] && s.v[1] == p[i].v[1] && s.v[2] == p[i].v[2]);
+		assert_quat_eq(quat_convert_quat48(p[i]), out[i]);
+		assert_quat_rotation_near(q[i], out[i], 1.5 * QUAT48_STEP + ROUNDING);
+		assert_quat_angle_le(q[i], out[i], 2 * sqrt(3) * QUAT48_STEP + ROUNDING);
+	}
+
+	free(q);
+	free(p);
+	free(out);
+} END_TEST
+
+START_TEST(_quat64_convert_quat) {
+	quat *q = compress_quats(.5);
+	quat64 *p = calloc(COMPRESS_COUNT, sizeof(quat64));
+	quat *out = calloc(COMPRESS_COUNT, sizeof(quat));
+
+	quat64_convert_quat_array(p, q, COMPRESS_COUNT);
+	quat_convert_quat64_array(out, p, COMPRESS_COUNT);
+
+	for (int i = 0; i < COMPRESS_COUNT; i++) {
+		const quat64 s = quat64_convert_quat(q[i]);
+		ck_assert(s.v[0] == p[i].v[0] && s.v[1] == p[i].v[1] && s.v[2] == p[i].v[2] && s.v[3] == p[i].v[3]);
+		assert_quat_eq(quat_convert_quat64(p[i]), out[i]);
+		assert_quat_rotation_near(q[i], out[i], .75 * QUAT64_STEP + ROUNDING);
+		assert_quat_angle_le(q[i], out[i], 2 * QUAT64_STEP + ROUNDING);
+	}
+
+	free(q);
+	free(p);
+	free(out);
+} END_TEST
+
 START_TEST(_quat4f) {
 	assert_quat_eq(quat4f(1, 0, 0, 1), quat4f(1, 0, 0, 1));
 } END_TEST
 
+START_TEST(_quat_conjugate) {
+	assert_quat_eq(quat4f(-1, -2, -3, 4), quat_conjugate(quat4f(1, 2, 3, 4)));
+} END_TEST
+
+START_TEST(_quat_euler) {
+	assert_quat_eq(quat_identity(), quat_euler(vec0()));
+
+	const float x = 0.3, y = -1.2, z = 2.5;
+	const quat q = quat_euler(vec3f(x, y, z));
+
+	const float cx = cosf(x / 2), cy = cosf(y / 2), cz = cosf(z / 2);
+	const float sx = sinf(x / 2), sy = sinf(y / 2), sz = sinf(z / 2);
+
+	ck_assert(fabsf(quat_x(q) - (sx * cy * cz - cx * sy * sz)) < 0.000001);
+	ck_assert(fabsf(quat_y(q) - (cx * sy * cz + sx * cy * sz)) < 0.000001);
+	ck_assert(fabsf(quat_z(q) - (cx * cy * sz - sx * sy * cz)) < 0.000001);
+	ck_assert(fabsf(quat_w(q) - (cx * cy * cz + sx * sy * sz)) < 0.000001);
+} END_TEST
+
+START_TEST(_quat_inverse) {
+	const quat q = quat4f(1, 2, 3, 4);
+	assert_vec_near(quat_identity(), quat_multiply(q, quat_inverse(q)), 0.000001);
+	assert_vec_near(quat_identity(), quat_multiply(quat_inverse(q), q), 0.000001);
+} END_TEST
+
+START_TEST(_quat_look_at) {
+	assert_quat_eq(quat_identity(), quat_look_at(vec0(), vec0()));
+	assert_vec_near(quat_identity(), quat_look_at(vec3f(1, 1, 1), vec3f(2, 1, 1)), 0.000001);
+
+	const vec eye = vec3f(1, 2, 3);
+	const vec targets[] = { vec3f(-4, 5, 2), vec3f(1, 2, -3), vec3f(3, 2, 3), vec3f(1, -2, 7) };
+
+	for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+		const quat q = quat_look_at(eye, targets[i]);
+		const vec forward = quat_rotate(q, vec3f(1, 0, 0));
+		assert_vec_near(vec_normalize(vec_subtract(targets[i], eye)), forward, 0.000001);
+
+		const vec right = quat_rotate(q, vec3f(0, 1, 0));
+		ck_assert(fabsf(vec_z(right)) < 0.000001);
+	}
+} END_TEST
+
+START_TEST(_quat_multiply) {
+	const quat a = quat4f(1, 2, 3, 4), b = quat4f(5, 6, 7, 8);
+	assert_quat_eq(quat4f(24, 48, 48, -6), quat_multiply(a, b));
+	assert_quat_eq(a, quat_multiply(a, quat_identity()));
+	assert_quat_eq(a, quat_multiply(quat_identity(), a));
+
+	const quat x = quat_euler(vec3f(0.3, 0, 0)), y = quat_euler(vec3f(0, 0.7, 0)), z = quat_euler(vec3f(0, 0, 1.1));
+	assert_vec_near(quat_euler(vec3f(0.3, 0.7, 1.1)), quat_multiply(z, quat_multiply(y, x)), 0.000001);
+} END_TEST
+
 START_TEST(_quat_new) {
 	assert_quat_eq(quat_identity(), quat_new(vec1f(1), 0));
-	assert_quat_eq(quat4f(1, 0, 0, 1), quat_new(vec3f(1, 1, 0), 1));
+	assert_quat_eq(quat_identity(), quat_new(vec0(), 1));
+	assert_vec_near(quat4f(sinf(.5) / sqrtf(2), sinf(.5) / sqrtf(2), 0, cosf(.5)), quat_new(vec3f(1, 1, 0), 1), 0.000001);
+	assert_vec_near(quat_new(vec3f(0, 0, 1), 2), quat_new(vec3f(0, 0, 5), 2), 0.000001);
+} END_TEST
+
+START_TEST(_quat_nlerp) {
+	const quat a = quat_new(vec3f(0, 0, 1), 0);
+	const quat b = quat_new(vec3f(0, 0, 1), 1);
+
+	assert_vec_near(a, quat_nlerp(a, b, 0), 0.000001);
+	assert_vec_near(b, quat_nlerp(a, b, 1), 0.000001);
+	assert_vec_near(quat_new(vec3f(0, 0, 1), .5), quat_nlerp(a, b, .5), 0.000001);
+
+	// the negated quaternion is the same rotation, and must take the shortest path
+	assert_vec_near(quat_new(vec3f(0, 0, 1), .5), quat_nlerp(a, vec_negate(b), .5), 0.000001);
+
+	quat qa[7], qb[7], out[7];
+	float t[7];
+
+	for (int i = 0; i < 7; i++) {
+		qa[i] = quat_euler(vec3f(i, -.5 * i, .25));
+		qb[i] = quat_euler(vec3f(-i, .3, i * i));
+		t[i] = i / 6.f;
+	}
+
+	// degenerate pairs yield the identity, whether in a batch of four or in the remainder
+	qa[1] = qb[1] = qa[5] = qb[5] = quat4f(0, 0, 0, 0);
+
+	quat_nlerp_array(out, qa, qb, t, 7);
+	for (int i = 0; i < 7; i++) {
+		assert_vec_near(quat_nlerp(qa[i], qb[i], t[i]), out[i], 0.000001);
+	}
+
+	assert_quat_eq(quat_identity(), out[1]);
+	assert_quat_eq(quat_identity(), out[5]);
+} END_TEST
+
+START_TEST(_quat_normalize) {
+	assert_quat_eq(quat_identity(), quat_normalize(quat4f(0, 0, 0, 2)));
+	assert_quat_eq(quat_identity(), quat_normalize(quat4f(0, 0, 0, 0)));
+	assert_quat_eq(quat4f(0, 1, 0, 0), quat_normalize(quat4f(0, 3, 0, 0)));
+	assert_vec_near(quat4f(.5, .5, .5, .5), quat_normalize(quat4f(2, 2, 2, 2)), 0.000001);
+
+	// degenerate quaternions in both the batch of four and the remainder
+	quat q[6] = {
+		quat4f(0, 0, 0, 2), quat4f(0, 3, 0, 0), quat4f(2, 2, 2, 2), quat4f(1, 2, 3, 4),
+		quat4f(-1, 0, 0, 1), quat4f(0, 0, 0, -3)
+	};
+	quat out[6];
+
+	quat_normalize_array(out, q, 6);
+	for (int i = 0; i < 6; i++) {
+		assert_vec_near(quat_normalize(q[i]), out[i], 0.0000001);
+	}
+	assert_quat_eq(quat_identity(), out[0]);
+	assert_quat_eq(quat_identity(), out[5]);
+
+	quat_normalize_fast_array(out, q, 6);
+	for (int i = 0; i < 6; i++) {
+		assert_vec_near(quat_normalize(q[i]), out[i], 0.0000005);
+	}
+	assert_quat_eq(quat_identity(), out[0]);
+	assert_quat_eq(quat_identity(), out[5]);
+
+	quat_normalize_array(q, q, 6);
+	for (int i = 0; i < 6; i++) {
+		assert_vec_near(q[i], out[i], 0.0000005);
+	}
+} END_TEST
+
+START_TEST(_quat_normalize_fast) {
+	assert_quat_eq(quat_identity(), quat_normalize_fast(quat4f(0, 0, 0, 0)));
+	assert_vec_near(quat4f(0, 1, 0, 0), quat_normalize_fast(quat4f(0, 3, 0, 0)), 0.0000005);
+
+	quat q = quat4f(0.3, -2, 7, 1e-3);
+	for (int i = 0; i < 100; i++) {
+		assert_vec_near(quat_normalize(q), quat_normalize_fast(q), 0.0000005);
+		q = quat_multiply(q, quat4f(0.1, 0.2, -0.3, 1.5));
+		q = vec_scale(q, 1 / vec_x(vec_sqrt(_mm_dp_ps(q, q, 0xF1))) * (i + 1));
+	}
+} END_TEST
+
+START_TEST(_quat_slerp) {
+	const quat a = quat_new(vec3f(1, 2, 3), .2);
+	const quat b = quat_new(vec3f(1, 2, 3), 2.2);
+
+	assert_vec_near(a, quat_slerp(a, b, 0), 0.000001);
+	assert_vec_near(b, quat_slerp(a, b, 1), 0.000001);
+
+	for (int i = 0; i <= 10; i++) {
+		assert_vec_near(quat_new(vec3f(1, 2, 3), .2 + .2 * i), quat_slerp(a, b, i / 10.f), 0.000001);
+		assert_vec_near(quat_new(vec3f(1, 2, 3), .2 + .2 * i), quat_slerp(a, vec_negate(b), i / 10.f), 0.000001);
+	}
+
+	// nearly parallel quaternions fall back to nlerp
+	assert_vec_near(a, quat_slerp(a, a, .5), 0.000001);
+	assert_vec_near(quat_new(vec3f(1, 2, 3), .2005), quat_slerp(a, quat_new(vec3f(1, 2, 3), .201), .5), 0.000001);
+
+	quat qa[11], qb[11], out[11];
+	float t[11];
+
+	for (int i = 0; i < 11; i++) {
+		qa[i] = quat_euler(vec3f(i, -.5 * i, .25));
+		qb[i] = i == 3 ? qa[i] : quat_euler(vec3f(-i, .3, i * i));
+		t[i] = i / 10.f;
+	}
+
+	quat_slerp_array(out, qa, qb, t, 11);
+	for (int i = 0; i < 11; i++) {
+		assert_vec_near(quat_slerp(qa[i], qb[i], t[i]), out[i], 0.000002);
+	}
+} END_TEST
+
+START_TEST(_quat_rotate) {
+	const quat q = quat_euler(vec3f(0, 0, M_PI_2));
+	assert_vec_near(vec3f(0, 1, 0), quat_rotate(q, vec3f(1, 0, 0)), 0.000001);
+	assert_vec_near(vec4f(-1, 0, 0, 1), quat_rotate(q, vec4f(0, 1, 0, 1)), 0.000001);
+
+	const quat a = quat_euler(vec3f(0.2, -0.5, 2.5)), b = quat_euler(vec3f(1, 0.1, -0.4));
+	const vec v = vec3f(3, -1, 2);
+	assert_vec_near(quat_rotate(a, quat_rotate(b, v)), quat_rotate(quat_multiply(a, b), v), 0.00001);
 } END_TEST
 
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("quat");
 
+	tcase_add_test(tcase, _dquat_new);
+	tcase_add_test(tcase, _dquat_multiply);
+	tcase_add_test(tcase, _dquat_normalize);
+	tcase_add_test(tcase, _dquat_skin_array);
+	tcase_add_test(tcase, _quat32_convert_quat);
+	tcase_add_test(tcase, _quat48_convert_quat);
 	tcase_add_test(tcase, _quat4f);
+	tcase_add_test(tcase, _quat64_convert_quat);
+	tcase_add_test(tcase, _quat_conjugate);
+	tcase_add_test(tcase, _quat_euler);
+	tcase_add_test(tcase, _quat_inverse);
+	tcase_add_test(tcase, _quat_look_at);
+	tcase_add_test(tcase, _quat_multiply);
 	tcase_add_test(tcase, _quat_new);
+	tcase_add_test(tcase, _quat_nlerp);
+	tcase_add_test(tcase, _quat_normalize);
+	tcase_add_test(tcase, _quat_normalize_fast);
+	tcase_add_test(tcase, _quat_rotate);
+	tcase_add_test(tcase, _quat_slerp);
 //	tcase_add_test(tcase, _quat_add);
 //	tcase_add_test(tcase, _quat_equal);
 
@@ -0,0 +1,266 @@
+/*
+ * Quemath: An SSE optimized math library for games, written in C99.
+ * Copyright (C) 2019 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdio.h>
+
+#include "random.h"
+
+/**
+ * @brief The scalar _xoshiro128++_ reference implementation.
+ */
+static uint32_t next(uint32_t s[4]) {
+	const uint32_t sum = s[0] + s[3];
+	const uint32_t result = ((sum << 7) | (sum >> 25)) + s[0];
+	const uint32_t t = s[1] << 9;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 11) | (s[3] >> 21);
+
+	return result;
+}
+
+static void jump(uint32_t s[4], const uint32_t polynomial[4]) {
+	uint32_t t[4] = { 0 };
+	for (int i = 0; i < 4; i++) {
+		for (int b = 0; b < 32; b++) {
+			if (polynomial[i] & (1u << b)) {
+				for (int j = 0; j < 4; j++) {
+					t[j] ^= s[j];
+				}
+			}
+			next(s);
+		}
+	}
+	memcpy(s, t, sizeof(t));
+}
+
+static const uint32_t jump_polynomial[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+static const uint32_t long_jump_polynomial[4] = { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+
+static void lane_state(const random4 *r, int lane, uint32_t s[4]) {
+	for (int i = 0; i < 4; i++) {
+		uint32_t words[4];
+		_mm_storeu_si128((__m128i *) words, r->s[i]);
+		s[i] = words[lane];
+	}
+}
+
+START_TEST(_random4_fill) {
+	random4 r = random4_new(1), q = r;
+
+	uint32_t out[11];
+	random4_fill(&r, out, 11);
+
+	for (int i = 0; i < 8; i += 4) {
+		uint32_t expected[4];
+		_mm_storeu_si128((__m128i *) expected, random4_next(&q));
+		ck_assert(memcmp(expected, out + i, sizeof(expected)) == 0);
+	}
+
+	uint32_t expected[4];
+	_mm_storeu_si128((__m128i *) expected, random4_next(&q));
+	ck_assert(memcmp(expected, out + 8, 3 * sizeof(uint32_t)) == 0);
+} END_TEST
+
+START_TEST(_random4_fill_float) {
+	random4 r = random4_new(2);
+
+	static float out[100003];
+	random4_fill_float(&r, out, 100003);
+
+	double sum = 0;
+	for (int i = 0; i < 100003; i++) {
+		ck_assert(out[i] >= 0 && out[i] < 1);
+		ck_assert(out[i] == ldexpf(truncf(ldexpf(out[i], 24)), -24));
+		sum += out[i];
+	}
+
+	ck_assert(fabs(sum / 100003 - .5) < .005);
+} END_TEST
+
+START_TEST(_random4_jump) {
+	random4 r = random4_new(3);
+
+	uint32_t s[4], t[4];
+	lane_state(&r, 0, s);
+
+	random4_jump(&r);
+	jump(s, jump_polynomial);
+
+	// lane 0 now begins lane 1's stream
+	lane_state(&r, 0, t);
+	ck_assert(memcmp(s, t, sizeof(s)) == 0);
+
+	random4_long_jump(&r);
+	jump(s, long_jump_polynomial);
+
+	lane_state(&r, 0, t);
+	ck_assert(memcmp(s, t, sizeof(s)) == 0);
+} END_TEST
+
+START_TEST(_random4_new) {
+	random4 r = random4_new(4);
+
+	uint32_t s[4][4];
+	lane_state(&r, 0, s[0]);
+
+	// each lane is one jump ahead of the last
+	for (int lane = 1; lane < 4; lane++) {
+		memcpy(s[lane], s[lane - 1], sizeof(s[lane]));
+		jump(s[lane], jump_polynomial);
+
+		uint32_t t[4];
+		lane_state(&r, lane, t);
+		ck_assert(memcmp(s[lane], t, sizeof(t)) == 0);
+	}
+
+	// and different seeds yield different streams
+	ck_assert(!ivec_equals(r.s[0], random4_new(5).s[0]));
+
+	for (int i = 0; i < 1000; i++) {
+		uint32_t words[4];
+		_mm_storeu_si128((__m128i *) words, random4_next(&r));
+
+		for (int lane = 0; lane < 4; lane++) {
+			ck_assert_int_eq(next(s[lane]), words[lane]);
+		}
+	}
+} END_TEST
+
+START_TEST(_random4_next_float_range) {
+	random4 r = random4_new(7);
+
+	const vec mins = vec4f(1, -1, .1f, -1e-30f);
+	const vec maxs = vec4f(nextafterf(1, 2), 0, .3f, 0);
+
+	for (int i = 0; i < 100000; i++) {
+		const vec v = random4_next_float_range(&r, mins, maxs);
+		ck_assert_int_eq(0xf, _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(v, mins), _mm_cmplt_ps(v, maxs))));
+		ck_assert(vec_x(v) == 1);
+	}
+
+	// a range so narrow that every sum rounds to the upper bound
+	const vec v = random4_next_float_range(&r, vec_new(1e8f), vec_new(nextafterf(1e8f, 1e9f)));
+	ck_assert(ivec_equals(_mm_castps_si128(v), _mm_castps_si128(vec_new(1e8f))));
+} END_TEST
+
+START_TEST(_random4_next_range) {
+	random4 r = random4_new(8);
+
+	const ivec mins = ivec4i(-10, 0, 5, INT32_MIN);
+	const ivec maxs = ivec4i(10, 1, 6, INT32_MAX);
+
+	for (int i = 0; i < 100000; i++) {
+		const ivec v = random4_next_range(&r, mins, maxs);
+		ck_assert(_mm_testc_si128(_mm_cmplt_epi32(v, maxs), ivec_true()));
+		ck_assert(_mm_testz_si128(_mm_cmplt_epi32(v, mins), ivec_true()));
+		ck_assert_int_eq(0, ivec_y(v));
+		ck_assert_int_eq(5, ivec_z(v));
+	}
+} END_TEST
+
+START_TEST(_random4_next_range_unbiased) {
+	random4 r = random4_new(9), q = r;
+
+	// in a range of 3 * 2^30, the biased mapping returns multiples of three half of the time
+	const ivec mins = ivec0(), maxs = ivec_new((int) 0xc0000000);
+
+	const int iterations = 100000;
+
+	int biased = 0, unbiased = 0;
+	for (int i = 0; i < iterations; i++) {
+		uint32_t a[4], b[4];
+		_mm_storeu_si128((__m128i *) a, random4_next_range(&r, mins, maxs));
+		_mm_storeu_si128((__m128i *) b, random4_next_range_unbiased(&q, mins, maxs));
+
+		for (int j = 0; j < 4; j++) {
+			ck_assert(a[j] < 0xc0000000 && b[j] < 0xc0000000);
+			biased += a[j] % 3 == 0;
+			unbiased += b[j] % 3 == 0;
+		}
+	}
+
+	ck_assert(fabs(biased / (iterations * 4.0) - 1 / 2.0) < .01);
+	ck_assert(fabs(unbiased / (iterations * 4.0) - 1 / 3.0) < .01);
+
+	// and the smallest and largest ranges
+	for (int i = 0; i < 1000; i++) {
+		ck_assert(ivec_equals(ivec_new(7), random4_next_range_unbiased(&q, ivec_new(7), ivec_new(8))));
+		random4_next_range_unbiased(&q, ivec_new(INT32_MIN), ivec_new(INT32_MAX));
+	}
+} END_TEST
+
+START_TEST(_random8_new) {
+	random8 r = random8_new(6);
+	random4 q = random4_new(6);
+
+	for (int lane = 0; lane < 4; lane++) {
+		random4_jump(&q);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		ck_assert(ivec_equals(q.s[i], r.b.s[i]));
+	}
+
+	static uint32_t out[1003];
+	random8_fill(&r, out, 1003);
+
+	random8 p = random8_new(6);
+	for (int i = 0; i < 1000; i += 8) {
+		uint32_t expected[8];
+		_mm_storeu_si128((__m128i *) (expected + 0), random4_next(&p.a));
+		_mm_storeu_si128((__m128i *) (expected + 4), random4_next(&p.b));
+		ck_assert(memcmp(expected, out + i, sizeof(expected)) == 0);
+	}
+} END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("random");
+
+	tcase_add_test(tcase, _random4_fill);
+	tcase_add_test(tcase, _random4_fill_float);
+	tcase_add_test(tcase, _random4_jump);
+	tcase_add_test(tcase, _random4_new);
+	tcase_add_test(tcase, _random4_next_float_range);
+	tcase_add_test(tcase, _random4_next_range);
+	tcase_add_test(tcase, _random4_next_range_unbiased);
+	tcase_add_test(tcase, _random8_new);
+
+	Suite *suite = suite_create("random");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
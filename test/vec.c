@@ -23,6 +23,7 @@
 
 #include <check.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "vec.h"
 
@@ -36,6 +37,218 @@ static inline void assert_vec_eq(const vec a, const vec b) {
 				  vec_x(b), vec_y(b), vec_z(b), vec_w(b));
 }
 
+#define BATCH_COUNT 11
+
+static void random_vec3s(vec3 *out, size_t count) {
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (size_t i = 0; i < count; i++) {
+		rand = vec_random(rand);
+		out[i] = vec_vec3(vec_subtract(vec_scale(rand, 20), vec_new(10)));
+	}
+}
+
+static inline void assert_vec3_eq(const vec3 a, const vec3 b, float epsilon) {
+	assert_flt_eq(a.x, b.x, epsilon);
+	assert_flt_eq(a.y, b.y, epsilon);
+	assert_flt_eq(a.z, b.z, epsilon);
+}
+
+static half half_of_bits(uint32_t bits) {
+	return (half) _mm_extract_epi16(half_convert_vec(vec_cast_ivec(ivec_new((int) bits))), 0);
+}
+
+static half half_of(float f) {
+	return (half) _mm_extract_epi16(half_convert_vec(vec1f(f)), 0);
+}
+
+static uint32_t bits_of_half(half h) {
+	return (uint32_t) ivec_x(ivec_cast_vec(vec_convert_half(ivec1i(h))));
+}
+
+START_TEST(_half_convert_vec) {
+	const ivec h = half_convert_vec(vec4f(1, -2, 65504, .5));
+	ck_assert(ivec_equals(h, _mm_setr_epi16(0x3c00, (short) 0xc000, 0x7bff, 0x3800, 0, 0, 0, 0)));
+
+	// round to nearest even, at normal and subnormal precision
+	ck_assert_int_eq(0x3c00, half_of(1 + ldexpf(1, -11)));
+	ck_assert_int_eq(0x3c02, half_of(1 + 3 * ldexpf(1, -11)));
+	ck_assert_int_eq(0x7bff, half_of(65519.99));
+	ck_assert_int_eq(0x7c00, half_of(65520));
+	ck_assert_int_eq(0x0001, half_of(ldexpf(1, -24)));
+	ck_assert_int_eq(0x0000, half_of(ldexpf(1, -25)));
+	ck_assert_int_eq(0x0001, half_of(3 * ldexpf(1, -26)));
+	ck_assert_int_eq(0x0400, half_of(ldexpf(1, -14)));
+	ck_assert_int_eq(0x8000, half_of(-0.f));
+	ck_assert_int_eq(0x0000, half_of(ldexpf(1, -140)));
+
+	// infinity, and NaN quieted with its payload truncated
+	ck_assert_int_eq(0xfc00, half_of(-INFINITY));
+	ck_assert_int_eq(0x7e00, half_of_bits(0x7fc00000));
+	ck_assert_int_eq(0x7e00, half_of_bits(0x7f800001));
+	ck_assert_int_eq(0x7f00, half_of_bits(0x7fa00000));
+
+	// every half, other than NaN, survives the round trip
+	for (uint32_t i = 0; i < 0x10000; i++) {
+		if ((i & 0x7c00) != 0x7c00 || (i & 0x3ff) == 0) {
+			ck_assert_int_eq(i, half_of_bits(bits_of_half((half) i)));
+		}
+	}
+
+	ivec bits = ivec4i(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (int i = 0; i < 100000; i++) {
+		bits = _mm_add_epi32(_mm_mullo_epi32(bits, ivec_new(1664525)), ivec_new(1013904223));
+		const vec v = vec_cast_ivec(bits);
+		ck_assert(ivec_equals(half_convert_vec(v), half_convert_vec_soft(v)));
+	}
+} END_TEST
+
+START_TEST(_half_convert_vec_array) {
+	const size_t count = 0x10001;
+	float *f = calloc(count, sizeof(float));
+	half *h = calloc(count, sizeof(half));
+	half *h_sse = calloc(count, sizeof(half));
+
+	ivec bits = ivec4i(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (size_t i = 0; i < count; i++) {
+		bits = _mm_add_epi32(_mm_mullo_epi32(bits, ivec_new(1664525)), ivec_new(1013904223));
+		f[i] = vec_x(vec_cast_ivec(bits));
+	}
+
+	half_convert_vec_array(h, f, count);
+	half_convert_vec_array_sse(h_sse, f, count);
+	ck_assert(memcmp(h, h_sse, count * sizeof(half)) == 0);
+
+	free(f);
+	free(h);
+	free(h_sse);
+} END_TEST
+
+START_TEST(_vec_convert_half) {
+	assert_vec_eq(vec4f(1, -2, 65504, .5), vec_convert_half(_mm_setr_epi16(0x3c00, (short) 0xc000, 0x7bff, 0x3800, 0, 0, 0, 0)));
+
+	ck_assert_int_eq(0x33800000, bits_of_half(0x0001));
+	ck_assert_int_eq(0x387fc000, bits_of_half(0x03ff));
+	ck_assert_int_eq(0x80000000, bits_of_half(0x8000));
+	ck_assert_int_eq(0x7f800000, bits_of_half(0x7c00));
+	ck_assert_int_eq(0xffc00000, bits_of_half(0xfe00));
+	ck_assert_int_eq(0x7fc02000, bits_of_half(0x7c01));
+
+	for (int i = 0; i < 0x10000; i += 4) {
+		const ivec h = _mm_setr_epi16(i, i + 1, i + 2, i + 3, 0, 0, 0, 0);
+		ck_assert(ivec_equals(ivec_cast_vec(vec_convert_half(h)), ivec_cast_vec(vec_convert_half_soft(h))));
+	}
+} END_TEST
+
+static void random_normals(vec3 *out, size_t count) {
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (size_t i = 0; i < count; i++) {
+		vec v;
+		do {
+			rand = vec_random(rand);
+			v = vec3fv(vec_vec3(vec_subtract(vec_scale(rand, 2), vec_new(1))));
+		} while (vec_x(vec_length(v)) < .001f);
+		out[i] = vec_vec3(vec_normalize(v));
+	}
+}
+
+static void assert_vec_angle_lt(const vec a, const vec b, float degrees) {
+	const float sine = vec_x(vec_length(vec_cross(a, b)));
+	ck_assert_msg(vec_x(vec_dot3(a, b)) > 0 && sine < sinf(degrees * M_PI / 180),
+				  "(%g, %g, %g) != (%g, %g, %g)", vec_x(a), vec_y(a), vec_z(a), vec_x(b), vec_y(b), vec_z(b));
+}
+
+#define NORMAL_COUNT 10003
+
+START_TEST(_vec_convert_half_array) {
+	const size_t count = 0x10001;
+	half *h = calloc(count, sizeof(half));
+	float *f = calloc(count, sizeof(float));
+	float *f_sse = calloc(count, sizeof(float));
+
+	for (size_t i = 0; i < count; i++) {
+		h[i] = (half) i;
+	}
+
+	vec_convert_half_array(f, h, count);
+	vec_convert_half_array_sse(f_sse, h, count);
+	ck_assert(memcmp(f, f_sse, count * sizeof(float)) == 0);
+
+	free(h);
+	free(f);
+	free(f_sse);
+} END_TEST
+
+START_TEST(_oct_convert_vec) {
+	static vec3 normals[NORMAL_COUNT];
+	random_normals(normals, NORMAL_COUNT);
+
+	// the axes are exact, at both ends of the fold
+	const vec axes[] = { vec3f(1, 0, 0), vec3f(0, 1, 0), vec3f(0, 0, 1), vec3f(-1, 0, 0), vec3f(0, -1, 0), vec3f(0, 0, -1) };
+	for (size_t i = 0; i < sizeof(axes) / sizeof(axes[0]); i++) {
+		assert_vec_eq(axes[i], vec_convert_oct16(oct16_convert_vec(axes[i])));
+		assert_vec_eq(axes[i], vec_convert_oct32(oct32_convert_vec(axes[i])));
+	}
+
+	for (int i = 0; i < NORMAL_COUNT; i++) {
+		const vec n = vec3fv(normals[i]);
+
+		const vec a = vec_convert_oct16(oct16_convert_vec(n));
+		assert_flt_eq(1, vec_x(vec_length(a)), 1e-6);
+		assert_vec_angle_lt(n, a, 1);
+
+		const vec b = vec_convert_oct32(oct32_convert_vec(n));
+		assert_flt_eq(1, vec_x(vec_length(b)), 1e-6);
+		assert_vec_angle_lt(n, b, .004);
+	}
+} END_TEST
+
+START_TEST(_snorm_convert_vec) {
+	assert_vec_eq(vec4f(1, -1, 0, 1), vec_convert_snorm32(snorm32_convert_vec(vec4f(1, -1, 0, 2))));
+	assert_vec_eq(vec4f(1, -1, 0, -1), vec_convert_snorm64(snorm64_convert_vec(vec4f(1, -1, 0, -2))));
+
+	// the most negative encodings clamp to -1
+	assert_vec_eq(vec_new(-1), vec_convert_snorm32(0x80808080));
+	assert_vec_eq(vec_new(-1), vec_convert_snorm64((snorm64) { .v = { -32768, -32768, -32768, -32768 } }));
+
+	const vec abs = vec_new(-0.f);
+
+	vec rand = vec4f(0xfeed, 0xdad, 0xdead, 0xbeef);
+	for (int i = 0; i < 100000; i++) {
+		rand = vec_random(rand);
+		const vec v = vec_subtract(vec_scale(rand, 2), vec_new(1));
+
+		const vec a = vec_subtract(vec_convert_snorm32(snorm32_convert_vec(v)), v);
+		ck_assert(_mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(abs, a), vec_new(1.f / 254 + 1e-7f))) == 0xf);
+
+		const vec b = vec_subtract(vec_convert_snorm64(snorm64_convert_vec(v)), v);
+		ck_assert(_mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(abs, b), vec_new(1.f / 65534 + 1e-8f))) == 0xf);
+	}
+
+	vec4 v4[BATCH_COUNT], out32[BATCH_COUNT], out64[BATCH_COUNT];
+	snorm32 s32[BATCH_COUNT];
+	snorm64 s64[BATCH_COUNT];
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		rand = vec_random(rand);
+		v4[i] = vec_vec4(vec_subtract(vec_scale(rand, 2.5), vec_new(1.25)));
+	}
+
+	snorm32_convert_vec4_array(s32, v4, BATCH_COUNT);
+	vec4_convert_snorm32_array(out32, s32, BATCH_COUNT);
+
+	snorm64_convert_vec4_array(s64, v4, BATCH_COUNT);
+	vec4_convert_snorm64_array(out64, s64, BATCH_COUNT);
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		ck_assert_int_eq(snorm32_convert_vec(vec4fv(v4[i])), s32[i]);
+		ck_assert(memcmp(snorm64_convert_vec(vec4fv(v4[i])).v, s64[i].v, sizeof(snorm64)) == 0);
+		assert_vec_eq(vec_convert_snorm32(s32[i]), vec4fv(out32[i]));
+		assert_vec_eq(vec_convert_snorm64(s64[i]), vec4fv(out64[i]));
+	}
+} END_TEST
+
 START_TEST(_vec0) {
 	assert_vec_eq(vec4f(0, 0, 0, 0), vec0());
 } END_TEST
@@ -68,10 +281,53 @@ START_TEST(_vec4fv) {
 	assert_vec_eq(vec4f(1, 2, 3, 4), vec4fv((vec4) { 1, 2, 3, 4 }));
 } END_TEST
 
+START_TEST(_vec_acosf) {
+	for (float f = -1; f <= 1; f += 0.001) {
+		assert_flt_eq(acosf(f), vec_x(vec_acosf(vec1f(f))), 0.0000003);
+	}
+	assert_vec_eq(vec4f(0, M_PI_2, M_PI, M_PI_2), vec_acosf(vec4f(1, 0, -1, 0)));
+} END_TEST
+
 START_TEST(_vec_add) {
 	assert_vec_eq(vec_add(vec3f(1, 2, 3), vec3f(1, 1, 1)), vec3f(2, 3, 4));
 } END_TEST
 
+START_TEST(_vec_asinf) {
+	for (float f = -1; f <= 1; f += 0.001) {
+		assert_flt_eq(asinf(f), vec_x(vec_asinf(vec1f(f))), 0.0000003);
+	}
+	assert_vec_eq(vec4f(M_PI_2, 0, -M_PI_2, 0), vec_asinf(vec4f(1, 0, -1, 0)));
+} END_TEST
+
+START_TEST(_vec_atanf) {
+	for (float f = -100; f <= 100; f += 0.01) {
+		assert_flt_eq(atanf(f), vec_x(vec_atanf(vec1f(f))), 0.0000003);
+	}
+	assert_vec_eq(vec4f(M_PI_2, 0, -M_PI_2, M_PI_4), vec_atanf(vec4f(INFINITY, 0, -INFINITY, 1)));
+} END_TEST
+
+START_TEST(_vec_atan2f) {
+	for (float f = -M_PI; f <= M_PI; f += 0.001) {
+		const float y = 3 * sinf(f), x = 3 * cosf(f);
+		assert_flt_eq(atan2f(y, x), vec_x(vec_atan2f(vec1f(y), vec1f(x))), 0.0000005);
+	}
+	assert_vec_eq(vec4f(0, M_PI, M_PI_2, -M_PI_2), vec_atan2f(vec4f(0, 0, 1, -1), vec4f(1, -1, 0, 0)));
+	assert_vec_eq(vec4f(0, M_PI, -M_PI, 0), vec_atan2f(vec4f(0, 0, -0.f, 0), vec4f(0, -0.f, -0.f, 0)));
+} END_TEST
+
+START_TEST(_vec_cosf) {
+	for (float f = -8 * M_PI; f <= 8 * M_PI; f += 0.01) {
+		assert_flt_eq(cosf(f), vec_x(vec_cosf(vec1f(f))), 0.0000002);
+	}
+	assert_vec_eq(vec4f(1, -1, 1, -1), vec_cosf(vec4f(0, M_PI, 0, -M_PI)));
+} END_TEST
+
+START_TEST(_vec_cosf_fast) {
+	for (float f = -8 * M_PI; f <= 8 * M_PI; f += 0.01) {
+		assert_flt_eq(cosf(f), vec_x(vec_cosf_fast(vec1f(f))), 0.00002);
+	}
+} END_TEST
+
 START_TEST(_vec_cross) {
 	assert_vec_eq(vec3f(-3, 6, -3), vec_cross(vec3f(1, 2, 3), vec3f(4, 5, 6)));
 } END_TEST
@@ -88,6 +344,14 @@ START_TEST(_vec_divide) {
 	assert_vec_eq(vec3f(1, 2, 3), vec_divide(vec3f(1, 4, 9), vec4f(1, 2, 3, 1)));
 } END_TEST
 
+START_TEST(_vec_divide_fast) {
+	const vec v = vec_divide_fast(vec4f(1, 4, 9, 8), vec4f(1, 2, 3, 4));
+	assert_flt_eq(1, vec_x(v), 0.002);
+	assert_flt_eq(2, vec_y(v), 0.002);
+	assert_flt_eq(3, vec_z(v), 0.002);
+	assert_flt_eq(2, vec_w(v), 0.002);
+} END_TEST
+
 START_TEST(_vec_dot2) {
 	assert_vec_eq(vec1f( 1), vec_dot2(vec2f(1, 0), vec2f( 1, 0)));
 	assert_vec_eq(vec1f(-1), vec_dot2(vec2f(1, 0), vec2f(-1, 0)));
@@ -100,6 +364,27 @@ START_TEST(_vec_dot3) {
 	assert_vec_eq(vec1f( 0), vec_dot3(vec3f(1, 0, 0), vec3f( 0, 1, 0)));
 } END_TEST
 
+START_TEST(_vec_dot3_broadcast) {
+	assert_vec_eq(vec_new(32), vec_dot3_broadcast(vec4f(1, 2, 3, 4), vec4f(4, 5, 6, 7)));
+	assert_vec_eq(vec_new(0), vec_dot3_broadcast(vec3f(1, 0, 0), vec3f(0, 1, 0)));
+} END_TEST
+
+START_TEST(_vec_dot3x4) {
+	const vec a[4] = { vec4f(1, 2, 3, 4), vec4f(-1, 0, 1, 9), vec3f(1, 0, 0), vec4f(2, 2, 2, 2) };
+	const vec b[4] = { vec4f(4, 5, 6, 7), vec4f(1, 1, 1, 9), vec3f(-1, 0, 0), vec4f(.5, .25, .25, 2) };
+
+	const vec d = vec_dot3x4(a, b);
+	for (int i = 0; i < 4; i++) {
+		assert_flt_eq(vec_x(vec_dot3(a[i], b[i])), ((float *) &d)[i], 0.00001);
+	}
+	assert_vec_eq(vec4f(32, 0, -1, 2), d);
+} END_TEST
+
+START_TEST(_vec_dot4_broadcast) {
+	assert_vec_eq(vec_new(60), vec_dot4_broadcast(vec4f(1, 2, 3, 4), vec4f(4, 5, 6, 7)));
+	assert_vec_eq(vec_new(0), vec_dot4_broadcast(vec4f(1, 0, 0, 0), vec4f(0, 1, 0, 0)));
+} END_TEST
+
 START_TEST(_vec_equal) {
 	ck_assert_int_eq(1, vec_equal(vec_new(1), vec_new(1)));
 	ck_assert_int_eq(1, vec_equal(vec3f(1, 2, 3), vec3f(1, 2, 3)));
@@ -118,6 +403,11 @@ START_TEST(_vec_greater_than_equal) {
 	ck_assert_int_eq(1, vec_greater_than_equal(vec_new(0), vec_new(0)));
 } END_TEST
 
+START_TEST(_vec_horizontal_add) {
+	assert_vec_eq(vec_new(10), vec_horizontal_add(vec4f(1, 2, 3, 4)));
+	assert_vec_eq(vec_new(0), vec_horizontal_add(vec4f(1, -1, 2, -2)));
+} END_TEST
+
 START_TEST(_vec_length) {
 	assert_vec_eq(vec1f(1), vec_length(vec3f(1, 0, 0)));
 	assert_vec_eq(vec1f(2), vec_length(vec3f(2, 0, 0)));
@@ -146,6 +436,20 @@ START_TEST(_vec_multiply) {
 	assert_vec_eq(vec3f(4, 10, 18), vec_multiply(vec3f(1, 2, 3), vec3f(4, 5, 6)));
 } END_TEST
 
+START_TEST(_vec_multiply_add) {
+	assert_vec_eq(vec3f(5, 12, 21), vec_multiply_add(vec3f(1, 2, 3), vec3f(4, 5, 6), vec3f(1, 2, 3)));
+	assert_vec_eq(vec3f(3, 8, 15), vec_multiply_subtract(vec3f(1, 2, 3), vec3f(4, 5, 6), vec3f(1, 2, 3)));
+
+	// (1 + e)(1 - e) rounds to 1 unless the product is fused with the subtraction
+	const float e = 1.f / 8192;
+	const vec d = vec_multiply_subtract(vec_new(1 + e), vec_new(1 - e), vec_new(1));
+#if QUEMATH_HAS_FMA
+	assert_vec_eq(vec_new(-e * e), d);
+#else
+	assert_vec_eq(vec_new(0), d);
+#endif
+} END_TEST
+
 START_TEST(_vec_negate) {
 	assert_vec_eq(vec3f(-1, -2, -3), vec_negate(vec3f(1, 2, 3)));
 } END_TEST
@@ -196,12 +500,78 @@ START_TEST(_vec_random_range) {
 	}
 } END_TEST
 
+static double rcp(double x) {
+	return 1 / x;
+}
+
+static double rsqrt(double x) {
+	return 1 / sqrt(x);
+}
+
+#define ERROR_SAMPLES 1000000
+
+/**
+ * @return The @p i th of ERROR_SAMPLES floats, spaced evenly by exponent across `[2^-125, 2^125)`.
+ */
+static float error_sample(int i) {
+	return exp2f(-125 + 250. * i / ERROR_SAMPLES);
+}
+
+/**
+ * @brief Asserts the relative error of @p f against @p reference across the normal range.
+ */
+static void assert_vec_relative_error_lt(vec (*f)(const vec), double (*reference)(double), double error) {
+
+	double max = 0;
+	for (int i = 0; i < ERROR_SAMPLES; i += 4) {
+		const vec v = vec4f(error_sample(i), error_sample(i + 1), error_sample(i + 2), error_sample(i + 3));
+		const vec y = f(v);
+		for (int j = 0; j < 4; j++) {
+			const double expected = reference(((float *) &v)[j]);
+			max = fmax(max, fabs(((float *) &y)[j] - expected) / expected);
+		}
+	}
+	ck_assert_msg(max < error, "%g >= %g", max, error);
+}
+
+/**
+ * @brief Asserts the error of @p f against @p reference in ULP across the normal range, where
+ * one ULP is the spacing of floats in the binade of the exact result.
+ */
+static void assert_vec_ulp_error_lt(vec (*f)(const vec), double (*reference)(double), double error) {
+
+	double max = 0;
+	for (int i = 0; i < ERROR_SAMPLES; i += 4) {
+		const vec v = vec4f(error_sample(i), error_sample(i + 1), error_sample(i + 2), error_sample(i + 3));
+		const vec y = f(v);
+		for (int j = 0; j < 4; j++) {
+			const double expected = reference(((float *) &v)[j]);
+
+			int exponent;
+			frexp(expected, &exponent);
+
+			max = fmax(max, fabs(((float *) &y)[j] - expected) / ldexp(1, exponent - 24));
+		}
+	}
+	ck_assert_msg(max < error, "%g >= %g", max, error);
+}
+
+START_TEST(_vec_rcp) {
+	assert_vec_relative_error_lt(vec_rcp_estimate, rcp, 1.5 / 4096);
+	assert_vec_ulp_error_lt(vec_rcp_refined, rcp, 3);
+	assert_vec_ulp_error_lt(vec_rcp_precise, rcp, .5 + 1e-6);
+} END_TEST
+
 START_TEST(_vec_rsqrt) {
 	const vec v = vec_rsqrt(vec4f(1, 2, 3, 4));
 	assert_flt_eq(1 / sqrtf(1), vec_x(v), 0.001);
 	assert_flt_eq(1 / sqrtf(2), vec_y(v), 0.001);
 	assert_flt_eq(1 / sqrtf(3), vec_z(v), 0.001);
 	assert_flt_eq(1 / sqrtf(4), vec_w(v), 0.001);
+
+	assert_vec_relative_error_lt(vec_rsqrt_estimate, rsqrt, 1.5 / 4096);
+	assert_vec_ulp_error_lt(vec_rsqrt_refined, rsqrt, 4);
+	assert_vec_ulp_error_lt(vec_rsqrt_precise, rsqrt, 1.5);
 } END_TEST
 
 START_TEST(_vec_scale) {
@@ -216,6 +586,42 @@ START_TEST(_vec_scale_add) {
 	assert_vec_eq(vec0(), vec_scale_add(vec0(), vec0(), 1));
 } END_TEST
 
+START_TEST(_vec_sincosf) {
+	for (float f = -8 * M_PI; f <= 8 * M_PI; f += 0.01) {
+		const vec v = vec4f(f, f + 1, f + 2, f + 3);
+		vec s, c;
+		vec_sincosf(v, &s, &c);
+		assert_vec_eq(vec_sinf(v), s);
+		assert_vec_eq(vec_cosf(v), c);
+	}
+} END_TEST
+
+START_TEST(_vec_sincosf_array) {
+	float v[BATCH_COUNT], s[BATCH_COUNT], c[BATCH_COUNT];
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		v[i] = i - BATCH_COUNT / 2.f;
+	}
+
+	vec_sincosf_array(s, c, v, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_sinf(vec1f(v[i]))), s[i], __FLT_EPSILON__);
+		assert_flt_eq(vec_x(vec_cosf(vec1f(v[i]))), c[i], __FLT_EPSILON__);
+	}
+} END_TEST
+
+START_TEST(_vec_sinf) {
+	for (float f = -8 * M_PI; f <= 8 * M_PI; f += 0.01) {
+		assert_flt_eq(sinf(f), vec_x(vec_sinf(vec1f(f))), 0.0000002);
+	}
+	assert_vec_eq(vec4f(0, 1, 0, -1), vec_sinf(vec4f(0, M_PI / 2, 0, -M_PI / 2)));
+} END_TEST
+
+START_TEST(_vec_sinf_fast) {
+	for (float f = -8 * M_PI; f <= 8 * M_PI; f += 0.01) {
+		assert_flt_eq(sinf(f), vec_x(vec_sinf_fast(vec1f(f))), 0.00002);
+	}
+} END_TEST
+
 START_TEST(_vec_sqrt) {
 	assert_vec_eq(vec3f(1, 2, 3), vec_sqrt(vec3f(1, 4, 9)));
 	assert_vec_eq(vec3f(4, 5, 7), vec_sqrt(vec3f(16, 25, 49)));
@@ -228,6 +634,18 @@ START_TEST(_vec_subtract) {
 	assert_vec_eq(vec_subtract(vec3f(1, 2, 3), vec3f(2, 3, 4)), vec3f(-1, -1, -1));
 } END_TEST
 
+START_TEST(_vec_tanf) {
+	for (float f = -1.5; f <= 1.5; f += 0.01) {
+		assert_flt_eq(tanf(f), vec_x(vec_tanf(vec1f(f))), fabsf(tanf(f)) * 0.0000003 + 0.0000001);
+	}
+} END_TEST
+
+START_TEST(_vec_tanf_fast) {
+	for (float f = -1.5; f <= 1.5; f += 0.01) {
+		assert_flt_eq(tanf(f), vec_x(vec_tanf_fast(vec1f(f))), fabsf(tanf(f)) * 0.00002);
+	}
+} END_TEST
+
 START_TEST(_vec_xyz) {
 	assert_vec_eq(vec4f(1, 2, 3, 0), vec_xyz(vec4f(1, 2, 3, 4)));
 } END_TEST
@@ -240,10 +658,322 @@ START_TEST(_vec_zxy) {
 	assert_vec_eq(vec4f(3, 1, 2, 0), vec_zxy(vec4f(1, 2, 3, 4)));
 } END_TEST
 
+START_TEST(_vec3_add_array) {
+	vec3 a[BATCH_COUNT], b[BATCH_COUNT], out[BATCH_COUNT];
+	random_vec3s(a, BATCH_COUNT);
+	random_vec3s(b, BATCH_COUNT);
+
+	vec3_add_array(out, a, b, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_add(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.00001);
+	}
+} END_TEST
+
+START_TEST(_vec3_convert_half_array) {
+	vec3 v[BATCH_COUNT], out[BATCH_COUNT];
+	half h[BATCH_COUNT * 3];
+
+	random_vec3s(v, BATCH_COUNT);
+
+	half_convert_vec3_array(h, v, BATCH_COUNT);
+	vec3_convert_half_array(out, h, BATCH_COUNT);
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		ck_assert_int_eq(half_of(v[i].x), h[i * 3 + 0]);
+		ck_assert_int_eq(half_of(v[i].y), h[i * 3 + 1]);
+		ck_assert_int_eq(half_of(v[i].z), h[i * 3 + 2]);
+		assert_vec3_eq(v[i], out[i], 10 * ldexpf(1, -11));
+	}
+
+	vec2 v2[3] = { { .v = { 1, 2 } }, { .v = { 3, 4 } }, { .v = { 5, 6 } } }, out2[3];
+	half h2[6];
+
+	half_convert_vec2_array(h2, v2, 3);
+	vec2_convert_half_array(out2, h2, 3);
+	for (int i = 0; i < 3; i++) {
+		ck_assert(v2[i].x == out2[i].x && v2[i].y == out2[i].y);
+	}
+
+	vec4 v4[3] = { { .v = { 1, 2, 3, 4 } }, { .v = { -1, -2, -3, -4 } }, { .v = { .25, .5, 2048, 0 } } }, out4[3];
+	half h4[12];
+
+	half_convert_vec4_array(h4, v4, 3);
+	vec4_convert_half_array(out4, h4, 3);
+	for (int i = 0; i < 3; i++) {
+		assert_vec_eq(vec4fv(v4[i]), vec4fv(out4[i]));
+	}
+} END_TEST
+
+START_TEST(_vec3_convert_oct_array) {
+	vec3 v[BATCH_COUNT], out16[BATCH_COUNT], out32[BATCH_COUNT];
+	oct16 o16[BATCH_COUNT];
+	oct32 o32[BATCH_COUNT];
+
+	random_normals(v, BATCH_COUNT);
+
+	oct16_convert_vec3_array(o16, v, BATCH_COUNT);
+	vec3_convert_oct16_array(out16, o16, BATCH_COUNT);
+
+	oct32_convert_vec3_array(o32, v, BATCH_COUNT);
+	vec3_convert_oct32_array(out32, o32, BATCH_COUNT);
+
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		ck_assert_int_eq(oct16_convert_vec(vec3fv(v[i])), o16[i]);
+		ck_assert_int_eq(oct32_convert_vec(vec3fv(v[i])), o32[i]);
+		assert_vec_eq(vec_convert_oct16(o16[i]), vec3fv(out16[i]));
+		assert_vec_eq(vec_convert_oct32(o32[i]), vec3fv(out32[i]));
+	}
+} END_TEST
+
+START_TEST(_vec3_cross_array) {
+	vec3 a[BATCH_COUNT], b[BATCH_COUNT], out[BATCH_COUNT];
+	random_vec3s(a, BATCH_COUNT);
+	random_vec3s(b, BATCH_COUNT);
+
+	vec3_cross_array(out, a, b, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_cross(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.0001);
+	}
+} END_TEST
+
+START_TEST(_vec3_distance_array) {
+	vec3 a[BATCH_COUNT], b[BATCH_COUNT];
+	float out[BATCH_COUNT];
+	random_vec3s(a, BATCH_COUNT);
+	random_vec3s(b, BATCH_COUNT);
+
+	vec3_distance_array(out, a, b, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_distance(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.0001);
+	}
+} END_TEST
+
+START_TEST(_vec3_dot3_array) {
+	vec3 a[BATCH_COUNT], b[BATCH_COUNT];
+	float out[BATCH_COUNT];
+	random_vec3s(a, BATCH_COUNT);
+	random_vec3s(b, BATCH_COUNT);
+
+	vec3_dot3_array(out, a, b, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_dot3(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.0001);
+	}
+} END_TEST
+
+START_TEST(_vec3_length_array) {
+	vec3 v[BATCH_COUNT];
+	float out[BATCH_COUNT];
+	random_vec3s(v, BATCH_COUNT);
+
+	vec3_length_array(out, v, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_length(vec3fv(v[i]))), out[i], 0.0001);
+	}
+} END_TEST
+
+START_TEST(_vec3_normalize_array) {
+	vec3 v[BATCH_COUNT], out[BATCH_COUNT];
+	random_vec3s(v, BATCH_COUNT);
+
+	vec3_normalize_array(out, v, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_normalize(vec3fv(v[i]))), out[i], 0.00001);
+	}
+
+	vec3_normalize_array(v, v, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_vec3_eq(out[i], v[i], 0.00001);
+	}
+} END_TEST
+
+START_TEST(_vec3_scale_add_array) {
+	vec3 a[BATCH_COUNT], b[BATCH_COUNT], out[BATCH_COUNT];
+	random_vec3s(a, BATCH_COUNT);
+	random_vec3s(b, BATCH_COUNT);
+
+	vec3_scale_add_array(out, a, b, 0.5, BATCH_COUNT);
+	for (int i = 0; i < BATCH_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_scale_add(vec3fv(a[i]), vec3fv(b[i]), 0.5)), out[i], 0.00001);
+	}
+} END_TEST
+
+#define WIDE_COUNT 45
+
+typedef void (*vec3_array_kernel)(vec3 *out, const vec3 *a, const vec3 *b, size_t count);
+typedef void (*float_array_kernel)(float *out, const vec3 *a, const vec3 *b, size_t count);
+
+static inline void assert_vec3_array_kernels(vec3_array_kernel add, vec3_array_kernel cross, float_array_kernel distance, float_array_kernel dot3) {
+	vec3 a[WIDE_COUNT], b[WIDE_COUNT], zero[WIDE_COUNT] = { 0 }, out[WIDE_COUNT];
+	float f[WIDE_COUNT];
+
+	random_vec3s(a, WIDE_COUNT);
+	random_vec3s(b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		b[i] = vec_vec3(vec_yzx(vec3fv(b[i])));
+	}
+
+	// adding zero round trips every vector through the wide loads and stores exactly
+	add(out, a, zero, WIDE_COUNT);
+	ck_assert(memcmp(a, out, sizeof(a)) == 0);
+
+	add(out, a, b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_add(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.00001);
+	}
+
+	cross(out, a, b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_cross(vec3fv(a[i]), vec3fv(b[i]))), out[i], 0.0001);
+	}
+
+	distance(f, a, b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_distance(vec3fv(a[i]), vec3fv(b[i]))), f[i], 0.00001);
+	}
+
+	dot3(f, a, b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_dot3(vec3fv(a[i]), vec3fv(b[i]))), f[i], 0.0001);
+	}
+}
+
+typedef void (*unary_float_array_kernel)(float *out, const vec3 *v, size_t count);
+typedef void (*unary_vec3_array_kernel)(vec3 *out, const vec3 *v, size_t count);
+typedef void (*scale_add_array_kernel)(vec3 *out, const vec3 *a, const vec3 *b, float scale, size_t count);
+
+/**
+ * @brief Asserts that the wide kernels are bit exact with the SSE kernels, for every count up to
+ * WIDE_COUNT, as fused multiply-add is used by all of them or by none.
+ */
+static inline void assert_vec3_array_kernels_exact(vec3_array_kernel add, vec3_array_kernel cross,
+		float_array_kernel distance, float_array_kernel dot3, unary_float_array_kernel length,
+		unary_vec3_array_kernel normalize, scale_add_array_kernel scale_add) {
+
+	vec3 a[WIDE_COUNT], b[WIDE_COUNT], out[WIDE_COUNT], out_sse[WIDE_COUNT];
+	float f[WIDE_COUNT], f_sse[WIDE_COUNT];
+
+	random_vec3s(a, WIDE_COUNT);
+	random_vec3s(b, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		b[i] = vec_vec3(vec_yzx(vec3fv(b[i])));
+	}
+
+	for (size_t count = 0; count <= WIDE_COUNT; count++) {
+		memset(out, 0, sizeof(out));
+		memset(out_sse, 0, sizeof(out_sse));
+		memset(f, 0, sizeof(f));
+		memset(f_sse, 0, sizeof(f_sse));
+
+		add(out, a, b, count);
+		vec3_add_array_sse(out_sse, a, b, count);
+		ck_assert(memcmp(out, out_sse, sizeof(out)) == 0);
+
+		cross(out, a, b, count);
+		vec3_cross_array_sse(out_sse, a, b, count);
+		ck_assert(memcmp(out, out_sse, sizeof(out)) == 0);
+
+		normalize(out, a, count);
+		vec3_normalize_array_sse(out_sse, a, count);
+		ck_assert(memcmp(out, out_sse, sizeof(out)) == 0);
+
+		scale_add(out, a, b, 0.3, count);
+		vec3_scale_add_array_sse(out_sse, a, b, 0.3, count);
+		ck_assert(memcmp(out, out_sse, sizeof(out)) == 0);
+
+		distance(f, a, b, count);
+		vec3_distance_array_sse(f_sse, a, b, count);
+		ck_assert(memcmp(f, f_sse, sizeof(f)) == 0);
+
+		dot3(f, a, b, count);
+		vec3_dot3_array_sse(f_sse, a, b, count);
+		ck_assert(memcmp(f, f_sse, sizeof(f)) == 0);
+
+		length(f, a, count);
+		vec3_length_array_sse(f_sse, a, count);
+		ck_assert(memcmp(f, f_sse, sizeof(f)) == 0);
+	}
+}
+
+START_TEST(_vec3_array_avx2) {
+#if QUEMATH_AVX2
+	if (!cpu_has_avx2()) {
+		return;
+	}
+
+	assert_vec3_array_kernels(vec3_add_array_avx2, vec3_cross_array_avx2, vec3_distance_array_avx2, vec3_dot3_array_avx2);
+	assert_vec3_array_kernels_exact(vec3_add_array_avx2, vec3_cross_array_avx2, vec3_distance_array_avx2, vec3_dot3_array_avx2,
+		vec3_length_array_avx2, vec3_normalize_array_avx2, vec3_scale_add_array_avx2);
+
+	vec3 v[WIDE_COUNT], out[WIDE_COUNT];
+	float f[WIDE_COUNT];
+	random_vec3s(v, WIDE_COUNT);
+
+	vec3_length_array_avx2(f, v, WIDE_COUNT);
+	vec3_normalize_array_avx2(out, v, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_length(vec3fv(v[i]))), f[i], 0.00001);
+		assert_vec3_eq(vec_vec3(vec_normalize(vec3fv(v[i]))), out[i], 0.00001);
+	}
+
+	vec3_scale_add_array_avx2(out, v, v, 2, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_scale(vec3fv(v[i]), 3)), out[i], 0.00001);
+	}
+#endif
+} END_TEST
+
+START_TEST(_vec3_array_avx512) {
+#if QUEMATH_AVX512
+	if (!cpu_has_avx512()) {
+		return;
+	}
+
+	assert_vec3_array_kernels(vec3_add_array_avx512, vec3_cross_array_avx512, vec3_distance_array_avx512, vec3_dot3_array_avx512);
+	assert_vec3_array_kernels_exact(vec3_add_array_avx512, vec3_cross_array_avx512, vec3_distance_array_avx512, vec3_dot3_array_avx512,
+		vec3_length_array_avx512, vec3_normalize_array_avx512, vec3_scale_add_array_avx512);
+
+	vec3 v[WIDE_COUNT], out[WIDE_COUNT];
+	float f[WIDE_COUNT];
+	random_vec3s(v, WIDE_COUNT);
+
+	vec3_length_array_avx512(f, v, WIDE_COUNT);
+	vec3_normalize_array_avx512(out, v, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_flt_eq(vec_x(vec_length(vec3fv(v[i]))), f[i], 0.00001);
+		assert_vec3_eq(vec_vec3(vec_normalize(vec3fv(v[i]))), out[i], 0.00001);
+	}
+
+	vec3_scale_add_array_avx512(out, v, v, 2, WIDE_COUNT);
+	for (int i = 0; i < WIDE_COUNT; i++) {
+		assert_vec3_eq(vec_vec3(vec_scale(vec3fv(v[i]), 3)), out[i], 0.00001);
+	}
+#endif
+} END_TEST
+
+START_TEST(_vec3x4_load) {
+	const vec3 v[4] = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 10, 11, 12 } };
+	const vec3x4 soa = vec3x4_load(v);
+	assert_vec_eq(vec4f(1, 4, 7, 10), soa.x);
+	assert_vec_eq(vec4f(2, 5, 8, 11), soa.y);
+	assert_vec_eq(vec4f(3, 6, 9, 12), soa.z);
+
+	vec3 out[4];
+	vec3x4_store(soa, out);
+	for (int i = 0; i < 4; i++) {
+		assert_vec3_eq(v[i], out[i], 0.00001);
+	}
+} END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("vec");
 
+	tcase_add_test(tcase, _half_convert_vec);
+	tcase_add_test(tcase, _half_convert_vec_array);
+	tcase_add_test(tcase, _vec_convert_half);
+	tcase_add_test(tcase, _vec_convert_half_array);
+	tcase_add_test(tcase, _oct_convert_vec);
+	tcase_add_test(tcase, _snorm_convert_vec);
 	tcase_add_test(tcase, _vec0);
 	tcase_add_test(tcase, _vec1f);
 	tcase_add_test(tcase, _vec2f);
@@ -252,21 +982,45 @@ int main(int argc, char **argv) {
 	tcase_add_test(tcase, _vec3fv);
 	tcase_add_test(tcase, _vec4f);
 	tcase_add_test(tcase, _vec4fv);
+	tcase_add_test(tcase, _vec3_add_array);
+	tcase_add_test(tcase, _vec3_convert_half_array);
+	tcase_add_test(tcase, _vec3_convert_oct_array);
+	tcase_add_test(tcase, _vec3_cross_array);
+	tcase_add_test(tcase, _vec3_distance_array);
+	tcase_add_test(tcase, _vec3_dot3_array);
+	tcase_add_test(tcase, _vec3_length_array);
+	tcase_add_test(tcase, _vec3_normalize_array);
+	tcase_add_test(tcase, _vec3_scale_add_array);
+	tcase_add_test(tcase, _vec3_array_avx2);
+	tcase_add_test(tcase, _vec3_array_avx512);
+	tcase_add_test(tcase, _vec3x4_load);
+	tcase_add_test(tcase, _vec_acosf);
 	tcase_add_test(tcase, _vec_add);
+	tcase_add_test(tcase, _vec_asinf);
+	tcase_add_test(tcase, _vec_atanf);
+	tcase_add_test(tcase, _vec_atan2f);
+	tcase_add_test(tcase, _vec_cosf);
+	tcase_add_test(tcase, _vec_cosf_fast);
 	tcase_add_test(tcase, _vec_cross);
 	tcase_add_test(tcase, _vec_degrees);
 	tcase_add_test(tcase, _vec_distance);
 	tcase_add_test(tcase, _vec_divide);
+	tcase_add_test(tcase, _vec_divide_fast);
 	tcase_add_test(tcase, _vec_dot2);
 	tcase_add_test(tcase, _vec_dot3);
+	tcase_add_test(tcase, _vec_dot3_broadcast);
+	tcase_add_test(tcase, _vec_dot3x4);
+	tcase_add_test(tcase, _vec_dot4_broadcast);
 	tcase_add_test(tcase, _vec_equal);
 	tcase_add_test(tcase, _vec_greater_than);
 	tcase_add_test(tcase, _vec_greater_than_equal);
+	tcase_add_test(tcase, _vec_horizontal_add);
 	tcase_add_test(tcase, _vec_length);
 	tcase_add_test(tcase, _vec_less_than);
 	tcase_add_test(tcase, _vec_less_than_equal);
 	tcase_add_test(tcase, _vec_mix);
 	tcase_add_test(tcase, _vec_multiply);
+	tcase_add_test(tcase, _vec_multiply_add);
 	tcase_add_test(tcase, _vec_negate);
 	tcase_add_test(tcase, _vec_normalize);
 	tcase_add_test(tcase, _vec_normalize_fast);
@@ -274,11 +1028,18 @@ int main(int argc, char **argv) {
 	tcase_add_test(tcase, _vec_radians);
 	tcase_add_test(tcase, _vec_random);
 	tcase_add_test(tcase, _vec_random_range);
+	tcase_add_test(tcase, _vec_rcp);
 	tcase_add_test(tcase, _vec_rsqrt);
 	tcase_add_test(tcase, _vec_scale);
 	tcase_add_test(tcase, _vec_scale_add);
+	tcase_add_test(tcase, _vec_sincosf);
+	tcase_add_test(tcase, _vec_sincosf_array);
+	tcase_add_test(tcase, _vec_sinf);
+	tcase_add_test(tcase, _vec_sinf_fast);
 	tcase_add_test(tcase, _vec_sqrt);
 	tcase_add_test(tcase, _vec_subtract);
+	tcase_add_test(tcase, _vec_tanf);
+	tcase_add_test(tcase, _vec_tanf_fast);
 	tcase_add_test(tcase, _vec_xyz);
 	tcase_add_test(tcase, _vec_yzx);
 	tcase_add_test(tcase, _vec_zxy);